@@ -6,10 +6,15 @@
 #include <cstdio>
 #include <algorithm>
 #include <map>
+#include <vector>
 #include  <stdlib.h>
 
 #include "SegmenterManager.h"
 #include "Segmenter.h"
+#ifndef WIN32
+#include <unistd.h>
+#include "SegmentExecutor.h"
+#endif
 #include "csr_utils.h"
 
 using namespace std;
@@ -24,9 +29,45 @@ typedef struct {
 		/* Type-specific fields go here. */
 		SegmenterManager* m_segmgr; // only PySource is supported for the leak support of setField in other documents
 		Segmenter* m_thesaurus_seg; // used query thesaurus.
+		std::vector<Segmenter*>* m_seg_pool; // idle segmenters, taken and given back with the GIL held.
+#ifndef WIN32
+		SegmentExecutor* m_executor; // of segment_many, created by the 1st call.
+		int m_executor_threads;
+		int m_executor_users; // segment_many calls running, the executor is replaced only when 0.
+#endif
 } csfHelper_MMSegObject;
 
+/*
+The result of segment_offsets: (start, end) byte offsets of each token, as uint32 pairs.
+len() is the token count, o[i] is a (start, end) tuple, and the buffer protocol exposes
+the array itself, e.g. numpy.frombuffer(o, numpy.uint32).reshape(-1, 2)
+*/
+typedef struct {
+	PyObject_HEAD
+		std::vector<u4>* m_offsets;
+		Py_ssize_t m_shape[2];
+		Py_ssize_t m_strides[2];
+} csfHelper_OffsetsObject;
+
+/*
+The result of segment_iter: segments the input on demand, holding a Segmenter of the
+MMSeg object until the iterator is exhausted or freed.
+*/
+typedef struct {
+	PyObject_HEAD
+		csfHelper_MMSegObject* m_owner; // a reference, keeps the manager alive.
+		PyObject* m_source; // the str segmented in place, or NULL if copied.
+		std::string* m_copy;
+		Segmenter* m_seg; // NULL once exhausted.
+		const u1* m_base;
+		Py_ssize_t m_batch; // 0, yield str tokens; else MMSegOffsets of up to m_batch tokens.
+		int m_running; // a batch is being segmented without the GIL.
+} csfHelper_SegIterObject;
+
 PyObject * PyMmseg_Segment(PyObject * self, PyObject* args);
+PyObject * PyMmseg_SegmentOffsets(PyObject * self, PyObject* args);
+PyObject * PyMmseg_SegmentMany(PyObject * self, PyObject* args, PyObject* kwds);
+PyObject * PyMmseg_SegmentIter(PyObject * self, PyObject* args, PyObject* kwds);
 PyObject * PyMmseg_Thesaurus(PyObject * self, PyObject* args);
 
 static int PyMMSeg_init(csfHelper_MMSegObject *self, PyObject *args, PyObject *kwds);
@@ -35,6 +76,9 @@ static void PyMMSeg_dealloc(csfHelper_MMSegObject* self);
 
 static PyMethodDef PyMMSeg_Helper_methods[] = {  
 	{"segment", PyMmseg_Segment, METH_VARARGS},   
+	{"segment_offsets", PyMmseg_SegmentOffsets, METH_VARARGS},   
+	{"segment_many", (PyCFunction)PyMmseg_SegmentMany, METH_VARARGS | METH_KEYWORDS},   
+	{"segment_iter", (PyCFunction)PyMmseg_SegmentIter, METH_VARARGS | METH_KEYWORDS},   
 	{"thesaurus", PyMmseg_Thesaurus, METH_VARARGS},   
 	{"build_dict", PyMmseg_BuildDict, METH_VARARGS},   
 	{NULL, NULL}  
@@ -91,6 +135,103 @@ static PyTypeObject csfHelper_MMSegType = {
 	0, /*tp_weaklist*/
 };
 
+static void PyOffsets_dealloc(csfHelper_OffsetsObject* self);
+static Py_ssize_t PyOffsets_length(csfHelper_OffsetsObject* self);
+static PyObject* PyOffsets_item(csfHelper_OffsetsObject* self, Py_ssize_t i);
+static Py_ssize_t PyOffsets_getreadbuffer(csfHelper_OffsetsObject* self, Py_ssize_t segment, void** ptr);
+static Py_ssize_t PyOffsets_getsegcount(csfHelper_OffsetsObject* self, Py_ssize_t* lenp);
+static int PyOffsets_getbuffer(csfHelper_OffsetsObject* self, Py_buffer* view, int flags);
+
+static PySequenceMethods PyOffsets_as_sequence = {
+	(lenfunc)PyOffsets_length, /*sq_length*/
+	0, /*sq_concat*/
+	0, /*sq_repeat*/
+	(ssizeargfunc)PyOffsets_item, /*sq_item*/
+};
+
+static PyBufferProcs PyOffsets_as_buffer = {
+	(readbufferproc)PyOffsets_getreadbuffer, /*bf_getreadbuffer*/
+	0, /*bf_getwritebuffer*/
+	(segcountproc)PyOffsets_getsegcount, /*bf_getsegcount*/
+	0, /*bf_getcharbuffer*/
+	(getbufferproc)PyOffsets_getbuffer, /*bf_getbuffer*/
+	0, /*bf_releasebuffer*/
+};
+
+static PyTypeObject csfHelper_OffsetsType = {
+	PyObject_HEAD_INIT(NULL)
+	0, /*ob_size*/
+	"Coreseek.MMSegOffsets", /*tp_name*/
+	sizeof(csfHelper_OffsetsObject), /*tp_basicsize*/
+	0, /*tp_itemsize*/
+	(destructor)PyOffsets_dealloc, /*tp_dealloc*/
+	0, /*tp_print*/
+	0, /*tp_getattr*/
+	0, /*tp_setattr*/
+	0, /*tp_compare*/
+	0, /*tp_repr*/ 
+	0, /*tp_as_number*/
+	&PyOffsets_as_sequence, /*tp_as_sequence*/
+	0, /*tp_as_mapping*/
+	0, /*tp_hash */
+	0, /*tp_call*/
+	0, /*tp_str*/
+	0, /*tp_getattro*/
+	0, /*tp_setattro*/
+	&PyOffsets_as_buffer, /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags*/
+	"Coreseek MMSeg token offsets, uint32 (start, end) pairs", /* tp_doc */
+};
+
+static void PySegIter_dealloc(csfHelper_SegIterObject* self);
+static PyObject* PySegIter_next(csfHelper_SegIterObject* self);
+
+static PyTypeObject csfHelper_SegIterType = {
+	PyObject_HEAD_INIT(NULL)
+	0, /*ob_size*/
+	"Coreseek.MMSegIterator", /*tp_name*/
+	sizeof(csfHelper_SegIterObject), /*tp_basicsize*/
+	0, /*tp_itemsize*/
+	(destructor)PySegIter_dealloc, /*tp_dealloc*/
+	0, /*tp_print*/
+	0, /*tp_getattr*/
+	0, /*tp_setattr*/
+	0, /*tp_compare*/
+	0, /*tp_repr*/ 
+	0, /*tp_as_number*/
+	0, /*tp_as_sequence*/
+	0, /*tp_as_mapping*/
+	0, /*tp_hash */
+	0, /*tp_call*/
+	0, /*tp_str*/
+	0, /*tp_getattro*/
+	0, /*tp_setattro*/
+	0, /*tp_as_buffer*/
+	Py_TPFLAGS_DEFAULT, /*tp_flags*/
+	"Coreseek MMSeg token iterator", /* tp_doc */
+	0, /*tp_traverse*/
+	0, /*tp_clear*/
+	0, /*tp_richcompare*/
+	0, /*tp_weaklistoffset*/
+	PyObject_SelfIter, /*tp_iter*/
+	(iternextfunc)PySegIter_next, /*tp_iternext*/
+};
+
+static Segmenter* PyMMSeg_acquire(csfHelper_MMSegObject *self)
+{
+	if(!self->m_seg_pool->empty()) {
+		Segmenter* seg = self->m_seg_pool->back();
+		self->m_seg_pool->pop_back();
+		return seg;
+	}
+	return self->m_segmgr->getSegmenter(false);
+}
+
+static void PyMMSeg_release(csfHelper_MMSegObject *self, Segmenter* seg)
+{
+	self->m_seg_pool->push_back(seg);
+}
+
 static int PyMMSeg_init(csfHelper_MMSegObject *self, PyObject *args, PyObject *kwds) {
 	const char* key = NULL;
 	PyObject* pV = NULL;
@@ -103,27 +244,50 @@ static int PyMMSeg_init(csfHelper_MMSegObject *self, PyObject *args, PyObject *k
 		//printf("%d:%s\n",nRet, key);
 		if(nRet != 0) {
 			delete self->m_segmgr;
+			self->m_segmgr = NULL;
 			PyErr_SetString(PyExc_ValueError, "invalid dict_path");
 			return -1;
 		}
 	}
 	// 初始化 查询同义词需要的 segment
-	self->m_thesaurus_seg = self->m_segmgr->getSegmenter(false); 
+	if(!self->m_thesaurus_seg)
+		self->m_thesaurus_seg = self->m_segmgr->getSegmenter(false); 
+	if(!self->m_seg_pool)
+		self->m_seg_pool = new std::vector<Segmenter*>();
 	return 0;
 }
 
 static void PyMMSeg_dealloc(csfHelper_MMSegObject* self) {
+#ifndef WIN32
+	if(self->m_executor)
+	{
+		SegmentExecutor* executor = self->m_executor;
+		self->m_executor = NULL;
+		Py_BEGIN_ALLOW_THREADS
+		delete executor;
+		Py_END_ALLOW_THREADS
+	}
+#endif
 	if(self->m_thesaurus_seg) 
 	{
 		delete self->m_thesaurus_seg;
 		self->m_thesaurus_seg  = NULL;
 	}
 
+	if(self->m_seg_pool)
+	{
+		for(size_t i = 0; i < self->m_seg_pool->size(); i++)
+			delete (*self->m_seg_pool)[i];
+		delete self->m_seg_pool;
+		self->m_seg_pool = NULL;
+	}
+
 	if(self->m_segmgr)
 	{
 		delete self->m_segmgr;
 		self->m_segmgr = NULL;
 	}
+	self->ob_type->tp_free((PyObject*)self);
 }
 
 PyObject * PyMmseg_Segment(PyObject * self, PyObject* args)
@@ -135,7 +299,7 @@ PyObject * PyMmseg_Segment(PyObject * self, PyObject* args)
 		return NULL;
 	else
 	{
-		Segmenter* seg = self2->m_segmgr->getSegmenter(false); 
+		Segmenter* seg = PyMMSeg_acquire(self2);
 		seg->setBuffer((u1*)fromPython, (u4)strlen(fromPython));
 
 		PyObject* item;
@@ -153,13 +317,356 @@ PyObject * PyMmseg_Segment(PyObject * self, PyObject* args)
             Py_DECREF(item);
 			seg->popToken(len);
 		}
-		//FIXME: free the segmenter
-		delete seg;
+		PyMMSeg_release(self2, seg);
 
 		return seg_result;
 	}
 }
 
+/*
+segment_offsets(data) -> MMSegOffsets
+data is a str, or any object with the buffer interface. A str is segmented in place,
+others are copied once for the NUL terminator the segmenter needs.
+*/
+PyObject * PyMmseg_SegmentOffsets(PyObject * self, PyObject* args)
+{
+	csfHelper_MMSegObject *self2 = (csfHelper_MMSegObject *)self;
+	PyObject* source = NULL;
+	if (!PyArg_ParseTuple(args, "O", &source))
+		return NULL;
+	const char* data = NULL;
+	Py_ssize_t length = 0;
+	std::string copy;
+	if(PyString_Check(source)) {
+		data = PyString_AS_STRING(source);
+		length = PyString_GET_SIZE(source);
+	}else{
+		if(PyObject_AsReadBuffer(source, (const void**)&data, &length) != 0)
+			return NULL;
+		copy.assign(data, length);
+		data = copy.c_str();
+	}
+	if((unsigned long long)length >= 0xFFFFFFFFULL) {
+		PyErr_SetString(PyExc_ValueError, "data larger than 4G");
+		return NULL;
+	}
+
+	csfHelper_OffsetsObject* result = PyObject_New(csfHelper_OffsetsObject, &csfHelper_OffsetsType);
+	if(!result)
+		return NULL;
+	result->m_offsets = new std::vector<u4>();
+	result->m_offsets->reserve(length / 2 + 2); //at most a token per byte, usually 1/3 of that
+	Segmenter* seg = PyMMSeg_acquire(self2);
+	//source is kept by args, and the str is immutable.
+	Py_BEGIN_ALLOW_THREADS
+	seg->segmentOffsets((u1*)data, (u4)length, *result->m_offsets);
+	Py_END_ALLOW_THREADS
+	PyMMSeg_release(self2, seg);
+	return (PyObject*)result;
+}
+
+/*
+segment_many(docs, threads=<cpu count>) -> list of MMSegOffsets, in the order of docs.
+docs is a sequence of str (or buffer objects, copied). The documents are segmented
+without the GIL, on a thread pool of the MMSeg object. threads takes effect when the
+pool is (re)created, i.e. the 1st call, or a call while no other is running.
+*/
+PyObject * PyMmseg_SegmentMany(PyObject * self, PyObject* args, PyObject* kwds)
+{
+	csfHelper_MMSegObject *self2 = (csfHelper_MMSegObject *)self;
+	static char* kwlist[] = {(char*)"docs", (char*)"threads", NULL};
+	PyObject* docs = NULL;
+	int threads = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|i", kwlist, &docs, &threads))
+		return NULL;
+	PyObject* seq = PySequence_Fast(docs, "docs must be a sequence");
+	if(!seq)
+		return NULL;
+	Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+
+	//pin the inputs: seq holds the str items, the others are copied.
+	std::vector<const char*> datas(count);
+	std::vector<u4> lengths(count);
+	std::vector<std::string> copies(count);
+	for(Py_ssize_t i = 0; i < count; i++) {
+		PyObject* item = PySequence_Fast_GET_ITEM(seq, i);
+		const char* data = NULL;
+		Py_ssize_t length = 0;
+		if(PyString_Check(item)) {
+			data = PyString_AS_STRING(item);
+			length = PyString_GET_SIZE(item);
+		}else{
+			if(PyObject_AsReadBuffer(item, (const void**)&data, &length) != 0) {
+				Py_DECREF(seq);
+				return NULL;
+			}
+			copies[i].assign(data, length);
+			data = copies[i].c_str();
+		}
+		if((unsigned long long)length >= 0xFFFFFFFFULL) {
+			Py_DECREF(seq);
+			PyErr_SetString(PyExc_ValueError, "data larger than 4G");
+			return NULL;
+		}
+		datas[i] = data;
+		lengths[i] = (u4)length;
+	}
+
+	std::vector< std::vector<u4> > offsets(count);
+#ifndef WIN32
+	if(threads <= 0)
+		threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	if(threads <= 0)
+		threads = 1;
+	if(self2->m_executor && !self2->m_executor_users && self2->m_executor_threads != threads) {
+		//detach first, other threads may come in while the GIL is released.
+		SegmentExecutor* old = self2->m_executor;
+		self2->m_executor = NULL;
+		Py_BEGIN_ALLOW_THREADS
+		delete old;
+		Py_END_ALLOW_THREADS
+	}
+	if(!self2->m_executor) {
+		//getSegmenter is not thread-safe, the GIL is held here.
+		self2->m_executor = new SegmentExecutor();
+		self2->m_executor->init(self2->m_segmgr, threads);
+		self2->m_executor_threads = threads;
+	}
+	SegmentExecutor* executor = self2->m_executor;
+	self2->m_executor_users++;
+	Py_BEGIN_ALLOW_THREADS
+	std::vector<SegmentJob> jobs(count);
+	for(Py_ssize_t i = 0; i < count; i++) {
+		jobs[i].m_buffer = (u1*)datas[i];
+		jobs[i].m_length = lengths[i];
+		executor->submit(&jobs[i]);
+	}
+	for(Py_ssize_t i = 0; i < count; i++) {
+		jobs[i].wait();
+		offsets[i].swap(jobs[i].m_offsets);
+	}
+	Py_END_ALLOW_THREADS
+	self2->m_executor_users--;
+#else
+	//no thread pool on win32, still segmented without the GIL.
+	Segmenter* seg = PyMMSeg_acquire(self2);
+	Py_BEGIN_ALLOW_THREADS
+	for(Py_ssize_t i = 0; i < count; i++)
+		seg->segmentOffsets((u1*)datas[i], lengths[i], offsets[i]);
+	Py_END_ALLOW_THREADS
+	PyMMSeg_release(self2, seg);
+#endif
+	Py_DECREF(seq);
+
+	PyObject* results = PyList_New(count);
+	if(!results)
+		return NULL;
+	for(Py_ssize_t i = 0; i < count; i++) {
+		csfHelper_OffsetsObject* result = PyObject_New(csfHelper_OffsetsObject, &csfHelper_OffsetsType);
+		if(!result) {
+			Py_DECREF(results);
+			return NULL;
+		}
+		result->m_offsets = new std::vector<u4>();
+		result->m_offsets->swap(offsets[i]);
+		PyList_SET_ITEM(results, i, (PyObject*)result);
+	}
+	return results;
+}
+
+/*
+segment_iter(data, batch=0) -> iterator
+Yields the tokens as str, or with batch > 0, MMSegOffsets of up to batch tokens each,
+offsets relative to the start of data. Nothing is segmented ahead of the consumer.
+*/
+PyObject * PyMmseg_SegmentIter(PyObject * self, PyObject* args, PyObject* kwds)
+{
+	csfHelper_MMSegObject *self2 = (csfHelper_MMSegObject *)self;
+	static char* kwlist[] = {(char*)"data", (char*)"batch", NULL};
+	PyObject* source = NULL;
+	Py_ssize_t batch = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|n", kwlist, &source, &batch))
+		return NULL;
+	if(batch < 0) {
+		PyErr_SetString(PyExc_ValueError, "batch must not be negative");
+		return NULL;
+	}
+	const char* data = NULL;
+	Py_ssize_t length = 0;
+	if(PyString_Check(source)) {
+		data = PyString_AS_STRING(source);
+		length = PyString_GET_SIZE(source);
+	}else if(PyObject_AsReadBuffer(source, (const void**)&data, &length) != 0)
+		return NULL;
+	if((unsigned long long)length >= 0xFFFFFFFFULL) {
+		PyErr_SetString(PyExc_ValueError, "data larger than 4G");
+		return NULL;
+	}
+
+	csfHelper_SegIterObject* iter = PyObject_New(csfHelper_SegIterObject, &csfHelper_SegIterType);
+	if(!iter)
+		return NULL;
+	Py_INCREF(self);
+	iter->m_owner = self2;
+	iter->m_source = NULL;
+	iter->m_copy = NULL;
+	if(PyString_Check(source)) {
+		Py_INCREF(source);
+		iter->m_source = source;
+	}else{
+		iter->m_copy = new std::string(data, length);
+		data = iter->m_copy->c_str();
+	}
+	iter->m_base = (const u1*)data;
+	iter->m_batch = batch;
+	iter->m_running = 0;
+	iter->m_seg = PyMMSeg_acquire(self2);
+	iter->m_seg->setBuffer((u1*)data, (u4)length);
+	return (PyObject*)iter;
+}
+
+static void PySegIter_finish(csfHelper_SegIterObject* self)
+{
+	if(!self->m_seg)
+		return;
+	self->m_seg->flushStats();
+	PyMMSeg_release(self->m_owner, self->m_seg);
+	self->m_seg = NULL;
+}
+
+static PyObject* PySegIter_next(csfHelper_SegIterObject* self)
+{
+	if(self->m_running) {
+		PyErr_SetString(PyExc_ValueError, "iterator already executing");
+		return NULL;
+	}
+	Segmenter* seg = self->m_seg;
+	if(!seg)
+		return NULL;
+	u2 len = 0, symlen = 0;
+	if(!self->m_batch) {
+		const u1* tok = seg->peekToken(len, symlen);
+		if(!tok || !*tok || !len) {
+			PySegIter_finish(self);
+			return NULL;
+		}
+		PyObject* item = PyString_FromStringAndSize((const char*)tok, len);
+		seg->popToken(len);
+		return item;
+	}
+
+	csfHelper_OffsetsObject* result = PyObject_New(csfHelper_OffsetsObject, &csfHelper_OffsetsType);
+	if(!result)
+		return NULL;
+	result->m_offsets = new std::vector<u4>();
+	std::vector<u4>& offsets = *result->m_offsets;
+	Py_ssize_t count = 0;
+	int end = 0;
+	self->m_running = 1;
+	Py_BEGIN_ALLOW_THREADS
+	offsets.reserve(self->m_batch * 2 < 65536 ? self->m_batch * 2 : 65536);
+	for(; count < self->m_batch; count++) {
+		const u1* tok = seg->peekToken(len, symlen);
+		if(!tok || !*tok || !len) {
+			end = 1;
+			break;
+		}
+		u4 start = (u4)(seg->m_buffer_ptr - self->m_base);
+		seg->popToken(len);
+		offsets.push_back(start);
+		offsets.push_back(start + len);
+	}
+	Py_END_ALLOW_THREADS
+	self->m_running = 0;
+	if(end)
+		PySegIter_finish(self);
+	if(!count) {
+		Py_DECREF(result);
+		return NULL;
+	}
+	return (PyObject*)result;
+}
+
+static void PySegIter_dealloc(csfHelper_SegIterObject* self)
+{
+	PySegIter_finish(self);
+	Py_XDECREF(self->m_source);
+	delete self->m_copy;
+	Py_DECREF(self->m_owner);
+	PyObject_Del(self);
+}
+
+static void PyOffsets_dealloc(csfHelper_OffsetsObject* self)
+{
+	delete self->m_offsets;
+	PyObject_Del(self);
+}
+
+static Py_ssize_t PyOffsets_length(csfHelper_OffsetsObject* self)
+{
+	return (Py_ssize_t)(self->m_offsets->size() / 2);
+}
+
+static PyObject* PyOffsets_item(csfHelper_OffsetsObject* self, Py_ssize_t i)
+{
+	if(i < 0 || i >= PyOffsets_length(self)) {
+		PyErr_SetString(PyExc_IndexError, "index out of range");
+		return NULL;
+	}
+	return Py_BuildValue("(II)", (*self->m_offsets)[i*2], (*self->m_offsets)[i*2+1]);
+}
+
+static Py_ssize_t PyOffsets_getreadbuffer(csfHelper_OffsetsObject* self, Py_ssize_t segment, void** ptr)
+{
+	if(segment != 0) {
+		PyErr_SetString(PyExc_SystemError, "accessing non-existent segment");
+		return -1;
+	}
+	*ptr = self->m_offsets->empty() ? (void*)"" : (void*)&(*self->m_offsets)[0];
+	return (Py_ssize_t)(self->m_offsets->size() * sizeof(u4));
+}
+
+static Py_ssize_t PyOffsets_getsegcount(csfHelper_OffsetsObject* self, Py_ssize_t* lenp)
+{
+	if(lenp)
+		*lenp = (Py_ssize_t)(self->m_offsets->size() * sizeof(u4));
+	return 1;
+}
+
+static int PyOffsets_getbuffer(csfHelper_OffsetsObject* self, Py_buffer* view, int flags)
+{
+	if(flags & PyBUF_WRITABLE) {
+		PyErr_SetString(PyExc_BufferError, "MMSegOffsets is read-only");
+		return -1;
+	}
+	self->m_shape[0] = PyOffsets_length(self);
+	self->m_shape[1] = 2;
+	self->m_strides[0] = sizeof(u4) * 2;
+	self->m_strides[1] = sizeof(u4);
+	view->buf = self->m_offsets->empty() ? (void*)"" : (void*)&(*self->m_offsets)[0];
+	view->obj = (PyObject*)self;
+	Py_INCREF(self);
+	view->len = (Py_ssize_t)(self->m_offsets->size() * sizeof(u4));
+	view->readonly = 1;
+	if((flags & PyBUF_ND) == PyBUF_ND) {
+		view->itemsize = sizeof(u4);
+		view->format = (flags & PyBUF_FORMAT) ? (char*)"I" : NULL;
+		view->ndim = 2;
+		view->shape = self->m_shape;
+		view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->m_strides : NULL;
+	}else{
+		//plain bytes
+		view->itemsize = 1;
+		view->format = NULL;
+		view->ndim = 1;
+		view->shape = NULL;
+		view->strides = NULL;
+	}
+	view->suboffsets = NULL;
+	view->internal = NULL;
+	return 0;
+}
+
 PyObject * PyMmseg_Thesaurus(PyObject * self, PyObject* args)
 {
 	csfHelper_MMSegObject *self2 = (csfHelper_MMSegObject *)self;
@@ -226,6 +733,10 @@ PyObject * PyMmseg_BuildDict(PyObject * self, PyObject* args)
 	 csfHelper_MMSegType.tp_new = PyType_GenericNew;
 	 if (PyType_Ready(&csfHelper_MMSegType) < 0)
 		 return -1;
+	 if (PyType_Ready(&csfHelper_OffsetsType) < 0)
+		 return -1;
+	 if (PyType_Ready(&csfHelper_SegIterType) < 0)
+		 return -1;
 	 return PyModule_AddObject(m, "MMSeg", (PyObject *)&csfHelper_MMSegType);
  }
 
@@ -19,7 +19,7 @@ if sys.platform == "win32":
 else:
     include_dirs = ['/usr/local/include/mmseg']
     library_dirs = ['/usr/local/lib']
-    libraries = ['mmseg']
+    libraries = ['mmseg', 'pthread']
 
 module1 = Extension('cmmseg',
 		    define_macros = define_macros,
@@ -10,6 +10,15 @@ rs = seg.segment((u'中文分词').encode('utf-8'))
 for i in rs:
     print i.decode('utf-8')
 
+# (start, end) byte offsets, no string object per token.
+text = (u'中文分词').encode('utf-8')
+for start, end in seg.segment_offsets(text):
+    print start, end, text[start:end].decode('utf-8')
+
+# tokens on demand, for large inputs.
+for i in seg.segment_iter(text):
+    print i.decode('utf-8')
+
 for i in seg.thesaurus((u'一丁点儿').encode('utf-8')):
 	print i
 print '-------'
\ No newline at end of file
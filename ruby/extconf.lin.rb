@@ -7,4 +7,8 @@ require 'mkmf'
 dir_config('mmseg')
 $libs = append_library($libs, "stdc++")
 $libs = append_library($libs, "mmseg")
+$libs = append_library($libs, "pthread")
+# segmentOffsets runs without the GVL, ruby 2.0 and later.
+have_header('ruby/thread.h')
+have_func('rb_thread_call_without_gvl', 'ruby/thread.h')
 create_makefile("mmseg")
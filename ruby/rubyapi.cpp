@@ -4,7 +4,11 @@
 #include <cstdio>
 
 #include <ctype.h>
+#include <vector>
 #include <ruby.h>
+#ifdef HAVE_RUBY_THREAD_H
+#include <ruby/thread.h>
+#endif
 
 /* Ruby 1.7 defines NUM2LL(), LL2NUM() and ULL2NUM() macros */
 #ifndef NUM2LL
@@ -40,6 +44,9 @@
 #ifndef RARRAY_PTR
 # define RARRAY_PTR(x) RARRAY(x)->ptr
 #endif
+#ifndef RB_GC_GUARD
+# define RB_GC_GUARD(v) (*(volatile VALUE *)&(v))
+#endif
 
 #include <stdio.h>
 #include <stdexcept>
@@ -55,6 +62,7 @@
 
 #include "SegmenterManager.h"
 #include "Segmenter.h"
+#include "csr_mutex.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,12 +71,58 @@ extern "C" {
 //fixme, unload when so unload?
 css::SegmenterManager g_mgr;
 int g_bInited = 0;
+//guards g_mgr init, its segmenter freelist, and g_seg_pool.
+//the GVL is released while segmenting, so do not count on it.
+CsrMutex g_mgr_lock;
+std::vector<css::Segmenter*> g_seg_pool; //idle segmenters of createSeg and segmentOffsets
+
+/*
+@return 0, ok
+*/
+static int
+mmseg_init_mgr
+	(const char* dict_path)
+{
+	int nRet = 0;
+	g_mgr_lock.lock();
+	if(!g_bInited) {
+		nRet = g_mgr.init(dict_path);
+		if(nRet == 0)
+			g_bInited = 1;
+	}
+	g_mgr_lock.unlock();
+	return nRet;
+}
+
+static css::Segmenter*
+mmseg_acquire()
+{
+	css::Segmenter* seg = NULL;
+	g_mgr_lock.lock();
+	if(!g_seg_pool.empty()) {
+		seg = g_seg_pool.back();
+		g_seg_pool.pop_back();
+	}else
+		seg = g_mgr.getSegmenter(false);
+	g_mgr_lock.unlock();
+	return seg;
+}
+
+static void
+mmseg_release
+	(css::Segmenter* seg)
+{
+	g_mgr_lock.lock();
+	g_seg_pool.push_back(seg);
+	g_mgr_lock.unlock();
+}
 
 static void
 mmseg_dfree
     (void *cd)
 {
-	//printf("needs to clean up");
+	//the segmenter of createSeg goes back to the pool.
+	mmseg_release((css::Segmenter*)cd);
 }
 
 #define MMSEG_FREE mmseg_dfree
@@ -109,33 +163,20 @@ mmseg_initialize(VALUE self){
 
 static VALUE mmseg_next(VALUE self)
 {
-  u2 tok_len = 0;
-  int nPos = 0;
   css::Segmenter* seg = NULL;
   Data_Get_Struct(self, css::Segmenter, seg);
   //printf("%d",seg); //check is got it
-  if(seg){
-	u2 len = 0, symlen = 0;
-	char* tok = (char*)seg->peekToken(len,symlen);
-	//printf("%s\t",tok);
-	//FIXME: if ruby version do not enbale symlen, the len and symlen always the same.
-	if(!tok || !*tok || !len)
-		tok_len = 0;
-	else
-		tok_len = len;
-	seg->popToken(len);
-  }
-  //update position info
-  VALUE vPos = rb_iv_get(self, "@end");
-  if(!NIL_P(vPos)){
-	nPos = FIX2INT(vPos);
-  }
-  rb_iv_set(self, "@start", INT2NUM(nPos));
-  rb_iv_set(self, "@end", INT2NUM(nPos+tok_len));
-  if(tok_len)
-	return self;
-  else
+  css::TokenInfo info;
+  if(!seg || !seg->nextToken(info)) {
+	//no more token, start and end stay at the end.
+	VALUE vPos = rb_iv_get(self, "@end");
+	rb_iv_set(self, "@start", vPos);
 	return Qnil;
+  }
+  //the offsets from the segmenter, right after a synonym too.
+  rb_iv_set(self, "@start", INT2NUM(info.offset));
+  rb_iv_set(self, "@end", INT2NUM(info.offset + info.length));
+  return self;
 }
 
 static VALUE mmseg_start(VALUE self) {  
@@ -184,19 +225,16 @@ mmseg_open
 	return Qnil;
   
   if (!g_bInited && TYPE(dict_path) == T_STRING) {
-	int nRet = g_mgr.init(STR2CSTR(dict_path));
+	int nRet = mmseg_init_mgr(STR2CSTR(dict_path));
 	if(nRet != 0) {
 		// should throw an exception
 		rb_fatal("Can NOT init the segment library.");
 		return Qnil;
 	}
-	g_bInited = 1;
   }
   if(g_bInited){
 	//do segment
-	css::Segmenter* seg = g_mgr.getSegmenter();
-	//hacking
-	long ptr = (long)seg;
+	css::Segmenter* seg = mmseg_acquire();
 	seg->setBuffer((u1*)pstr,len);
 	self = Data_Wrap_Struct(self, NULL, MMSEG_FREE, (void *)seg);
   }else
@@ -205,12 +243,76 @@ mmseg_open
   return self;
 }
 	
+struct mmseg_offsets_args {
+	css::Segmenter* seg;
+	u1* buf;
+	u4 length;
+	std::vector<u4>* offsets;
+};
+
+static void*
+mmseg_offsets_nogvl
+	(void* data)
+{
+	mmseg_offsets_args* args = (mmseg_offsets_args*)data;
+	args->seg->segmentOffsets(args->buf, args->length, *args->offsets);
+	return NULL;
+}
+
+/*
+Mmseg.segmentOffsets(dict_path, str) -> String
+Segments the whole str without the GVL, returns the (start, end) byte offsets of each token
+packed as native uint32, i.e. offsets.unpack("L*").each_slice(2)
+*/
+static VALUE
+mmseg_segment_offsets
+	(VALUE self, VALUE dict_path, VALUE str)
+{
+	Check_Type(str, T_STRING);
+	if (!g_bInited && TYPE(dict_path) == T_STRING) {
+		if(mmseg_init_mgr(RSTRING_PTR(dict_path)) != 0)
+			rb_raise(rb_eRuntimeError, "Can NOT init the segment library.");
+	}
+	if(!g_bInited)
+		rb_raise(rb_eRuntimeError, "dict_path expected");
+
+	//a frozen copy shares the buffer, and can not be changed by other threads meanwhile.
+	VALUE frozen = rb_str_new_frozen(str);
+	long len = RSTRING_LEN(frozen);
+	u1* buf = (u1*)RSTRING_PTR(frozen);
+	std::string copy;
+	if(buf[len]) {
+		//a shared substring, not NUL terminated.
+		copy.assign((const char*)buf, len);
+		buf = (u1*)copy.c_str();
+	}
+
+	std::vector<u4> offsets;
+	offsets.reserve(len / 2 + 2);
+	mmseg_offsets_args args;
+	args.seg = mmseg_acquire();
+	args.buf = buf;
+	args.length = (u4)len;
+	args.offsets = &offsets;
+#ifdef HAVE_RB_THREAD_CALL_WITHOUT_GVL
+	rb_thread_call_without_gvl(mmseg_offsets_nogvl, &args, NULL, NULL);
+#else
+	mmseg_offsets_nogvl(&args);
+#endif
+	mmseg_release(args.seg);
+	RB_GC_GUARD(frozen);
+	if(offsets.empty())
+		return rb_str_new("", 0);
+	return rb_str_new((const char*)&offsets[0], offsets.size() * sizeof(u4));
+}
+
 VALUE cMMseg;
 
 void Init_mmseg() {
   cMMseg = rb_define_class("Mmseg", rb_cData);
   rb_define_alloc_func(cMMseg, mmseg_s_allocate);
   rb_define_singleton_method(cMMseg, "createSeg", RUBY_METHOD_FUNC(mmseg_open), 2);
+  rb_define_singleton_method(cMMseg, "segmentOffsets", RUBY_METHOD_FUNC(mmseg_segment_offsets), 2);
   rb_define_method(cMMseg, "initialize", RUBY_METHOD_FUNC(mmseg_initialize), 0);
   rb_define_method(cMMseg, "setText", RUBY_METHOD_FUNC(mmseg_settext), 1);
   rb_define_method(cMMseg, "next", RUBY_METHOD_FUNC(mmseg_next), 0);
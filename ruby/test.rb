@@ -8,6 +8,12 @@ while t.next()
 	print '　'
 end
 
+# all offsets at once, segmented without the GVL
+Mmseg.segmentOffsets(".",txt).unpack("L*").each_slice(2) { |s, e|
+	print txt.byteslice(s...e)
+	print '　'
+}
+
 50000.times {
 #5.times {
 	t.setText(txt)
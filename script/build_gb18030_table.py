@@ -0,0 +1,61 @@
+#!/usr/bin/python
+# -*- coding: utf-8 -*-
+# Build src/css/gb18030_table.h from the gb18030 codec of python.
+#   python build_gb18030_table.py > ../src/css/gb18030_table.h
+from __future__ import print_function
+import sys
+
+def unichr_(c):
+	try:
+		return unichr(c)
+	except NameError:
+		return chr(c)
+
+def decode2(b1, b2):
+	try:
+		s = bytearray([b1, b2]).decode('gb18030')
+	except UnicodeDecodeError:
+		return 0
+	if len(s) != 1:
+		return 0
+	return ord(s)
+
+def main():
+	print('//generated by script/build_gb18030_table.py, do NOT edit.')
+	print('')
+	print('//two bytes, lead 0x81-0xFE, trail 0x40-0x7E 0x80-0xFE. 0, not mapped')
+	print('const static u2 gb2_table[] = {')
+	for b1 in range(0x81, 0xFF):
+		codes = []
+		for b2 in list(range(0x40, 0x7F)) + list(range(0x80, 0xFF)):
+			codes.append(hex(decode2(b1, b2)))
+		for i in range(0, len(codes), 16):
+			print(','.join(codes[i:i+16]) + ',')
+	print('};')
+	print('')
+	# four bytes of BMP chars, runs of (linear index, code point)
+	pairs = []
+	for c in range(0x80, 0x10000):
+		if 0xD800 <= c <= 0xDFFF:
+			continue
+		b = bytearray(unichr_(c).encode('gb18030'))
+		if len(b) != 4:
+			continue
+		linear = (((b[0] - 0x81) * 10 + (b[1] - 0x30)) * 126 + (b[2] - 0x81)) * 10 + (b[3] - 0x30)
+		pairs.append((linear, c))
+	pairs.sort()
+	ranges = []
+	for linear, c in pairs:
+		if ranges and linear - ranges[-1][0] == c - ranges[-1][1] and linear == ranges[-1][2] + 1:
+			ranges[-1][2] = linear
+		else:
+			ranges.append([linear, c, linear])
+	print('//four bytes of BMP chars, each run is (linear index, code point, last linear index)')
+	print('//linear index = (((b1-0x81)*10 + (b2-0x30))*126 + (b3-0x81))*10 + (b4-0x30)')
+	print('const static u4 gb4_ranges[][3] = {')
+	for r in ranges:
+		print('{%d,%s,%d},' % (r[0], hex(r[1]), r[2]))
+	print('};')
+
+if __name__ == '__main__':
+	main()
@@ -1,5 +1,8 @@
 ﻿#/usr/bin/python
 # -*- coding: utf-8 -*-
+# Build src/css/tolowercase.h from tolower.txt.
+#   python build_tolower_table.py tolower.txt > ../src/css/tolowercase.h
+from __future__ import print_function
 import sys
 import unicodedata
 import re
@@ -15,29 +18,6 @@ def getNum(leftK):
 		idxleftK = eval(leftK)
 	return idxleftK
 
-def dump(i, table):
-	#print table
-	print '//'+hex(i/256-1),hex(i)
-	#print 'const static u2 table_'+hex(i/256-1)+'[] = {'
-	print 'const static u2 table_'+str(i/256-1)+'[] = {'
-	line = ''
-	for j in range(0,256):
-		#print hex(j) +'->'+hex(table[j]),
-		if j and j % 16 == 0:
-			print line;
-			line = ''
-		line = line + hex(table[j])+','
-	print line[:-1]
-	print '};'
-	#dump convert table
-	print '/*'
-	for j in range(0,256):
-		#print i-255+j, table[j]
-		if i-256+j and table[j]:
-			print (unichr(i-256+j)+'>'+unichr(table[j])).encode('UTF-8'),
-	print '*/'
-	pass
-	
 def main():
 	fh = codecs.open(sys.argv[1],"r", "UTF-8")
 	lines = fh.readlines()
@@ -77,8 +57,7 @@ def main():
 				#Russian char made things harder.
 				bSkipOverride = 0;
 				if bSkipOverride and trans_table[idxleftK] and trans_table[idxleftK] != idxrightK:
-					print leftK, rightK, "inconst conver",idxleftK,idxrightK,trans_table[idxleftK]
-					print (unichr(idxleftK) + ',' + unichr(idxrightK) + ',' + unichr(trans_table[idxleftK])).encode('UTF-8')
+					print(leftK, rightK, "inconst conver",idxleftK,idxrightK,trans_table[idxleftK], file=sys.stderr)
 					pass
 					
 				trans_table[idxleftK] = idxrightK
@@ -99,7 +78,7 @@ def main():
 				
 				for i in range(0,len(from_range)):
 					if trans_table[from_range[i]] and trans_table[from_range[i]] != to_range[i]:
-						print "inconst conver",from_range[i],to_range[i],trans_table[idxleftK]
+						print("inconst conver",from_range[i],to_range[i],trans_table[idxleftK], file=sys.stderr)
 					#print from_range[i],to_range[i]
 					trans_table[from_range[i]] = to_range[i]
 				#print getNum(strbegin),getNum(strend)
@@ -136,43 +115,30 @@ def main():
 	trans_table[ord(u'｀')] =ord('`')
 	
 	#dump the trans-table
-	#page size = 256
-	#print trans_table
-	trans_page = [0]*256
-	idx_page = [0]*256
-	i = 0
-	for i in range(0,65536):
-		if i%256 == 0:
-			bOutput = 0
-			for j in range(0,256):
-				if trans_page[j]:
-					bOutput = 1
-					break
-			if bOutput:
-				#print trans_page
-				idx_page[i/256-1] = 1;
-				dump(i,trans_page)
-			trans_page = [0]*256
-		if trans_table[i]:
-			trans_page[i%256] = trans_table[i]
-	
-	bOutput = 0
-	for j in range(0,256):
-		if trans_page[j]:
-			bOutput = 1
-			break
-	if bOutput:
-		#print trans_page
-		idx_page[i/256] = 1;
-		dump(i+1,trans_page)
-	print 'const static u2 table_index[] = {' 
-	for j in range(0,256):
-		if idx_page[j]:
-			print 'table_'+str(j),
-		else:
-			print 'NULL',
-		if j != 255:
-			print ',',
-	print '};'
+	#page size = 256, all the pages without a char share page 0.
+	pages = [[0]*256]
+	index = []
+	for hi in range(0,256):
+		page = trans_table[hi*256:(hi+1)*256]
+		if page not in pages:
+			pages.append(page)
+		index.append(pages.index(page))
+	print('//generated by script/build_tolower_table.py, do NOT edit.')
+	print('')
+	print('//page of each high byte in lower_pages')
+	print('const static u1 lower_page_index[256] = {')
+	for i in range(0,256,16):
+		print(','.join([str(p) for p in index[i:i+16]]) + ',')
+	print('};')
+	print('')
+	print('//lower case of each low byte, 0 is the char itself')
+	print('const static u2 lower_pages[][256] = {')
+	for page in pages:
+		print('{')
+		for i in range(0,256,16):
+			print(','.join([hex(c) for c in page[i:i+16]]) + ',')
+		print('},')
+	print('};')
+
 if __name__ == "__main__":
      main()
\ No newline at end of file
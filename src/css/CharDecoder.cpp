@@ -0,0 +1,111 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <string.h>
+#include "CharDecoder.h"
+
+namespace css {
+
+u4 CharDecoder::decode(const u1* ptr, const u1* end, const u1* tags)
+{
+	u4 n = 0;
+	u2 off = 0;
+	m_base = ptr;
+	if(m_flags)
+		tags = NULL;	//of the chars before normalized
+	while(n < BLOCK_SIZE && ptr < end && *ptr) {
+		//ASCII without NUL, 8 bytes a time.
+		if(n + 8 <= BLOCK_SIZE && ptr + 8 <= end) {
+			u8 w;
+			memcpy(&w, ptr, 8);
+			if(!(w & 0x8080808080808080ULL)
+				&& !((w - 0x0101010101010101ULL) & ~w & 0x8080808080808080ULL)) {
+				for(u4 k = 0; k < 8; k++) {
+					int iCode = ptr[k];
+					if(m_flags)
+						iCode = m_normalizer->map(iCode, m_flags);
+					m_code[n + k] = iCode;
+					m_length[n + k] = 1;
+					m_tag[n + k] = tagOf(iCode, tags, off + k);
+					m_offset[n + k] = off + k;
+				}
+				off += 8;
+				n += 8;
+				ptr += 8;
+				continue;
+			}
+		}
+		u1 v = *ptr;
+		int iCode = v;
+		u1 len = 1;
+		if(v >= 0x80) {
+			if((v & 0xE0) == 0xC0)
+				len = 2;
+			else if((v & 0xF0) == 0xE0)
+				len = 3;
+			else if((v & 0xF8) == 0xF0)
+				len = 4;
+			if(len == 1)
+				iCode = -1;
+			else{
+				iCode = v & (0x7F >> len);
+				for(u1 k = 1; k < len; k++) {
+					u1 c = ptr[k];
+					if(!c) {
+						iCode = 0; //unexpected end
+						break;
+					}
+					if((c & 0xC0) != 0x80) {
+						iCode = -1;
+						break;
+					}
+					iCode = (iCode<<6) + (c & 0x3F);
+				}
+				if(iCode < 0)
+					len = 1;
+			}
+		}
+		if(iCode > 0 && m_flags)
+			iCode = m_normalizer->map(iCode, m_flags);
+		m_code[n] = iCode;
+		m_length[n] = len;
+		m_tag[n] = tagOf(iCode, tags, off);
+		m_offset[n] = off;
+		n++;
+		if(!iCode)
+			break;
+		ptr += len;
+		off += len;
+	}
+	if(!n) {
+		m_code[0] = 0;
+		m_length[0] = 0;
+		m_tag[0] = 0;
+		m_offset[0] = 0;
+		n = 1;
+	}
+	m_count = n;
+	return n;
+}
+
+} /* End of namespace css */
@@ -0,0 +1,109 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_CharDecoder_h
+#define css_CharDecoder_h
+
+#include "csr_typedefs.h"
+#include "SegmentPkg.h"
+#include "CharNormalizer.h"
+
+namespace css {
+
+/*
+Decodes UTF-8 a block of chars a time, into parallel arrays of code point, byte length and class tag.
+- ASCII is checked 8 bytes a time.
+- decoding is the same as csrUTF8Decode: a wrong byte is a char of code -1 and length 1;
+  a char cut by NUL is code 0, the block ends there.
+- with normalize flags, the code and tag are of the normalized char.
+- the block is kept, a window starts inside it goes on from there.
+*/
+class CharDecoder {
+public:
+	CharDecoder():m_tagger(NULL), m_normalizer(NULL), m_flags(0), m_base(NULL), m_count(0) {}
+	void init(ChineseCharTaggerImpl* tagger, const CharNormalizer* normalizer, u1 flags) {
+		if(!normalizer)
+			flags = 0;
+		if(tagger != m_tagger || normalizer != m_normalizer || flags != m_flags)
+			clear();
+		m_tagger = tagger;
+		m_normalizer = normalizer;
+		m_flags = flags;
+	}
+	/**
+	 *  Drop the block, the text it was decoded from is gone.
+	 */
+	void clear() {
+		m_base = NULL;
+		m_count = 0;
+	}
+	u4 count() const { return m_count; }
+	/**
+	 *  @return index of the char start at ptr in the block, count() if not in it.
+	 */
+	inline u4 find(const u1* ptr) const {
+		if(ptr < m_base || !m_count)
+			return m_count;
+		u4 off = (u4)(ptr - m_base);
+		u4 lo = 0, hi = m_count;
+		while(lo < hi) {
+			u4 mid = (lo + hi) / 2;
+			if(m_offset[mid] < off)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if(lo < m_count && m_offset[lo] == off)
+			return lo;
+		return m_count;
+	}
+	/**
+	 *  Decode the chars start at ptr, up to BLOCK_SIZE, the chars start before end only.
+	 *  At end or NUL, the block is a char of code 0.
+	 *  @param tags tags of SegmentPkg::tagData from ptr on, used instead of tagging if set.
+	 *  @return count of chars, at least 1
+	 */
+	u4 decode(const u1* ptr, const u1* end, const u1* tags = NULL);
+public:
+	const static u4 BLOCK_SIZE = 64;
+	int m_code[BLOCK_SIZE];
+	u1 m_length[BLOCK_SIZE];
+	u1 m_tag[BLOCK_SIZE];	//as peekToken's, the class letter of ChineseCharTaggerImpl
+	u2 m_offset[BLOCK_SIZE];	//from the block start
+protected:
+	//a tag of tagData is 0 where it gave up, e.g. 4 bytes chars.
+	inline u1 tagOf(int iCode, const u1* tags, u4 off) {
+		if(tags && tags[off])
+			return (tags[off] & 0x3F) + 'a' - 1;
+		return m_tagger->tagClass((u2)iCode);
+	}
+protected:
+	ChineseCharTaggerImpl* m_tagger;
+	const CharNormalizer* m_normalizer;
+	u1 m_flags;
+	const u1* m_base;
+	u4 m_count;
+};
+
+} /* End of namespace css */
+#endif
@@ -0,0 +1,172 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <stdio.h>
+#include <vector>
+#include "CharNormalizer.h"
+#include "Utf8_16.h"
+
+namespace css {
+	using namespace csr;
+
+CharNormalizer::CharNormalizer()
+	:m_count(0)
+{
+	memset(m_pages, 0, sizeof(m_pages));
+}
+
+CharNormalizer::~CharNormalizer()
+{
+	for(int i = 0; i < 256; i++)
+		delete[] m_pages[i];
+}
+
+int CharNormalizer::load(const char* filename)
+{
+	FILE* fp = fopen(filename, "rb");
+	if(!fp)
+		return -1;
+	std::vector<u1> data;
+	u1 buf[64*1024];
+	size_t n;
+	while((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+		data.insert(data.end(), buf, buf + n);
+	fclose(fp);
+	if(data.empty())
+		return 0;
+	return attach(&data[0], (u4)data.size());
+}
+
+int CharNormalizer::attach(const u1* buf, u4 size)
+{
+	std::vector<u1> line;
+	const u1* end = buf + size;
+	const u1* ptr = buf;
+	if(size >= 3 && ptr[0] == 0xEF && ptr[1] == 0xBB && ptr[2] == 0xBF)
+		ptr += 3;
+	while(ptr < end) {
+		const u1* eol = ptr;
+		while(eol < end && *eol != '\n')
+			eol++;
+		//NUL terminated copy, csrUTF8Decode stops at NUL.
+		line.assign(ptr, eol);
+		line.push_back(0);
+		ptr = eol + 1;
+		const u1* p = &line[0];
+		while(*p == ' ' || *p == '\t')
+			p++;
+		if(!*p || *p == '#' || *p == '\r')
+			continue;
+		int code[2];
+		for(int i = 0; i < 2; i++) {
+			while(*p == ' ' || *p == '\t')
+				p++;
+			u2 len = 0;
+			code[i] = csrUTF8Decode(p, len);
+			if(code[i] <= 0 || code[i] > 0xFFFF)
+				return -2;
+			p += len;
+		}
+		u2*& page = m_pages[code[0]>>8];
+		if(!page) {
+			page = new u2[256];
+			memset(page, 0, sizeof(u2)*256);
+		}
+		page[code[0]&0xFF] = (u2)code[1];
+		m_count++;
+	}
+	return 0;
+}
+
+void NormalizedText::fill(u4 pos, u4 need)
+{
+	u1 bLower = (m_flags & CharNormalizer::NORMALIZE_CASE) != 0;
+	const u1* src = &m_base[m_src];
+	u1 buf[4];
+	need += NORMALIZE_BATCH; //a call per char costs more than the normalizing
+	while(m_src < m_limit && (pos > m_src || m_len - m_npos[pos] < need)) {
+		//ASCII, 8 bytes a time.
+		if(m_src + 8 <= m_limit) {
+			u8 w;
+			memcpy(&w, src, 8);
+			if(!(w & 0x8080808080808080ULL)) {
+				if(bLower) {
+					//per byte, high bit set if >= 'A', and if > 'Z'; no carry as all bytes < 0x80.
+					u8 ge_A = w + 0x3F3F3F3F3F3F3F3FULL;
+					u8 gt_Z = w + 0x2525252525252525ULL;
+					w |= ((ge_A & ~gt_Z) & 0x8080808080808080ULL) >> 2;
+				}
+				memcpy(&m_text[m_len], &w, 8);
+				for(int k = 7; bLower && k >= 0; k--) {
+					if(m_text[m_len + k] != src[k]) {
+						m_changed = (i4)(m_src + k);
+						break;
+					}
+				}
+				for(u4 k = 0; k < 8; k++) {
+					m_npos[m_src + k] = (u2)(m_len + k);
+					m_opos[m_len + k] = (u2)(m_src + k);
+				}
+				m_src += 8;
+				m_len += 8;
+				src += 8;
+				continue;
+			}
+		}
+		u2 len = 1;
+		int iCode = *src;
+		if(iCode >= 0x80) {
+			iCode = csrUTF8Decode(src, len);
+			if(iCode <= 0)
+				len = 1; //a wrong byte is a char, as in Segmenter::peekToken
+		}
+		if(m_src + len > m_limit)
+			break;
+		int iNorm = iCode > 0 ? m_normalizer->map(iCode, m_flags) : iCode;
+		u2 nlen = len;
+		if(iNorm != iCode) {
+			nlen = (u2)csrUTF8Encode(buf, iNorm);
+			if(nlen > len) {
+				nlen = len;
+				iNorm = iCode;
+			}
+		}
+		m_npos[m_src] = (u2)m_len;
+		m_opos[m_len] = (u2)m_src;
+		for(u2 k = 1; k < nlen; k++)
+			m_opos[m_len + k] = NO_POS;
+		if(iNorm != iCode) {
+			memcpy(&m_text[m_len], buf, nlen);
+			m_changed = (i4)m_src;
+		}else
+			memcpy(&m_text[m_len], src, nlen);
+		m_src += len;
+		m_len += nlen;
+		src += len;
+	}
+	m_npos[m_src] = (u2)m_len;
+	m_opos[m_len] = (u2)m_src;
+	m_text[m_len] = 0;
+}
+
+} /* End of namespace css */
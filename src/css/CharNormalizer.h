@@ -0,0 +1,187 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_CharNormalizer_h
+#define css_CharNormalizer_h
+
+#include <string.h>
+#include "csr_typedefs.h"
+#include "SegmentPkg.h"
+#include "mmthunk.h"
+
+namespace css {
+
+/*
+Maps a char to the form used in dictionary lookups, each step enabled by a flag:
+- t2s, traditional to simplified, by the table of t2s.txt in the dictionary directory.
+- width, full-width ASCII and half-width katakana to their usual forms.
+- case, lower case by the ToLowerImpl tables.
+Only BMP chars are mapped.
+*/
+class CharNormalizer {
+public:
+	CharNormalizer();
+	~CharNormalizer();
+	/**
+	 *  Load the t2s table, each line is a traditional char and its simplified form,
+	 *  spaces between are allowed, a line start with # is a comment.
+	 *  @return 0, ok; -1, not exist; -2, format error
+	 */
+	int load(const char* filename);
+	/**
+	 *  Parse the t2s table from memory, the data is copied.
+	 *  @return 0, ok; -2, format error
+	 */
+	int attach(const u1* buf, u4 size);
+	u1 isLoad() const { return m_count != 0; }
+
+	inline int map(int iCode, u1 flags) const {
+		if(iCode < 0x80) {
+			if((flags & NORMALIZE_CASE) && iCode >= 'A' && iCode <= 'Z')
+				return iCode + 0x20;
+			return iCode;
+		}
+		if(iCode > 0xFFFF)
+			return iCode;
+		if(flags & NORMALIZE_T2S) {
+			const u2* page = m_pages[iCode>>8];
+			if(page && page[iCode&0xFF])
+				iCode = page[iCode&0xFF];
+		}
+		if(flags & NORMALIZE_WIDTH)
+			iCode = foldWidth(iCode);
+		if(flags & NORMALIZE_CASE)
+			iCode = foldCase(iCode);
+		return iCode;
+	}
+	static inline int foldWidth(int iCode) {
+		if(iCode >= 0xFF01 && iCode <= 0xFF5E)
+			return iCode - 0xFEE0;
+		if(iCode == 0x3000)
+			return ' ';
+		if(iCode >= 0xFF61 && iCode <= 0xFFEF) {
+			//half-width katakana and hangul, the lower table keeps their full-width forms.
+			u2 k = lower_pages[lower_page_index[0xFF]][iCode&0xFF];
+			if(k >= 0x3000)
+				return k;
+		}
+		return iCode;
+	}
+	static inline int foldCase(int iCode) {
+		if(iCode < 0x80) {
+			if(iCode >= 'A' && iCode <= 'Z')
+				return iCode + 0x20;
+			return iCode;
+		}
+		if(iCode > 0xFFFF)
+			return iCode;
+		if(iCode >= 0xFF00) {
+			//the lower table folds width too, keep full-width letters full-width.
+			if(iCode >= 0xFF21 && iCode <= 0xFF3A)
+				return iCode + 0x20;
+			return iCode;
+		}
+		ToLowerImpl lower;
+		//some upper case letters go to an accented lower one first, e.g. Ä>ä>a
+		return lower.toLower(lower.toLower((u2)iCode));
+	}
+public:
+	const static u1 NORMALIZE_CASE = 0x1;
+	const static u1 NORMALIZE_WIDTH = 0x2;
+	const static u1 NORMALIZE_T2S = 0x4;
+protected:
+	u2* m_pages[256];
+	u4 m_count;
+};
+
+#define NORMALIZE_LOOKAHEAD 192 //a synonym key is up to 64 bytes, a full-width char folds 3 bytes into 1.
+#define NORMALIZE_BATCH 64	//normalized ahead beyond the bytes asked
+
+/*
+The normalized text of a segment window, produced on demand just ahead of the dictionary lookups.
+A char never grows, if its normalized form is longer it is kept as is; positions of the
+window and of the normalized text map both ways at char boundaries.
+*/
+class NormalizedText {
+public:
+	NormalizedText():m_base(NULL) {}
+	/**
+	 *  Start a window at base, end is the end of the buffer.
+	 */
+	void reset(const u1* base, const u1* end, const CharNormalizer* normalizer, u1 flags) {
+		u4 limit = (u4)(end - base);
+		m_base = base;
+		m_limit = limit < MAX_LENGTH ? limit : MAX_LENGTH;
+		m_normalizer = normalizer;
+		m_flags = flags;
+		m_src = m_len = 0;
+		m_changed = -1;
+		m_npos[0] = m_opos[0] = 0;
+		m_text[0] = 0;
+	}
+	void clear() { m_base = NULL; }
+	const u1* base() const { return m_base; }
+	/**
+	 *  @return the normalized text of the char at window offset pos, with at least need
+	 *  bytes or the rest of the window, NUL terminated; NULL if pos is beyond the window.
+	 */
+	inline const u1* at(u4 pos, u4 need) {
+		if(pos > m_src || m_len - m_npos[pos] < need)
+			fill(pos, need);
+		if(pos > m_src)
+			return NULL;
+		return &m_text[m_npos[pos]];
+	}
+	/**
+	 *  @return whether a char from window offset pos on, in the part normalized, was changed;
+	 *  if so, the dictionary words not in normalized form need a lookup of the raw text too.
+	 */
+	inline u1 changedFrom(u4 pos) const { return m_changed >= (i4)pos; }
+	/**
+	 *  @return bytes in the window of nlen normalized bytes from pos, 0 if it ends inside a char.
+	 */
+	inline u2 origLength(u4 pos, u4 nlen) const {
+		u2 end = m_opos[m_npos[pos] + nlen];
+		if(end == NO_POS)
+			return 0;
+		return (u2)(end - pos);
+	}
+public:
+	const static u4 MAX_LENGTH = CHUNK_BUFFER_SIZE + NORMALIZE_LOOKAHEAD;
+protected:
+	void fill(u4 pos, u4 need);
+	const static u2 NO_POS = 0xFFFF;
+	const u1* m_base;
+	const CharNormalizer* m_normalizer;
+	u1 m_flags;
+	u4 m_limit;	//bytes of the window can be normalized
+	u4 m_src;	//bytes of the window normalized
+	u4 m_len;	//bytes of normalized text
+	i4 m_changed;	//window offset of the last char changed, -1 if none
+	u1 m_text[MAX_LENGTH + 8];
+	u2 m_npos[MAX_LENGTH + 1];	//window offset -> normalized offset
+	u2 m_opos[MAX_LENGTH + 1];	//normalized offset -> window offset, NO_POS inside a char
+};
+
+} /* End of namespace css */
+#endif
@@ -0,0 +1,273 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "DictBundle.h"
+#include "DictRegistry.h"
+#include "SegmenterManager.h"
+
+namespace css {
+
+const char bundle_head_mgc[] = "MMSB";
+
+typedef struct _csr_bundle_fileheader_tag{
+	char mg[4];
+	short version;
+	short reserve;
+	u4	section_count;
+	u4	section_align;
+}_csr_bundle_fileheader;
+
+typedef struct _csr_bundle_section_tag{
+	u4	type;
+	u4	offset;
+	u4	size;
+	u4	reserve;
+}_csr_bundle_section;
+
+//Segmenter_ConfigObj, in a layout independent of the compiler.
+typedef struct _csr_bundle_config_tag{
+	u1	merge_number_and_ascii;
+	u1	seperate_number_ascii;
+	u1	compress_space;
+	u1	omni_segmentation;
+	u1	number_and_ascii_joint[512];
+	u1	normalize;	//not in the bundles built before
+}_csr_bundle_config;
+
+static const struct {
+	u4 type;
+	const char* name;
+} g_bundle_files[] = {
+	{ DictBundle::SECTION_UNIGRAM, g_ngram_unigram_dict_name },
+	{ DictBundle::SECTION_KEYWORD, g_kword_unigram_dict_name },
+	{ DictBundle::SECTION_WEIGHT, g_wordweight_unigram_dict_name },
+	{ DictBundle::SECTION_SYNONYMS, g_synonyms_dict_name },
+	{ DictBundle::SECTION_THESAURUS, g_thesaurus_dict_name },
+	{ DictBundle::SECTION_T2S, g_t2s_dict_name },
+};
+
+DictBundle::DictBundle()
+	:m_file(NULL), m_base(NULL), m_count(0)
+{
+}
+
+DictBundle::~DictBundle()
+{
+	if(m_file)
+		csr_munmap_file(m_file);
+}
+
+/*
+@return 0, ok; -1, not exist
+*/
+static int read_file(const char* filename, std::vector<u1>& data)
+{
+	FILE* fp = fopen(filename, "rb");
+	if(!fp)
+		return -1;
+	u1 buf[64*1024];
+	size_t n;
+	data.clear();
+	while((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+		data.insert(data.end(), buf, buf + n);
+	fclose(fp);
+	return 0;
+}
+
+int DictBundle::build(const char* path, const char* target)
+{
+	std::string dir = path;
+#ifdef WIN32
+	if(dir.empty() || dir[dir.size()-1] != '\\')
+		dir += '\\';
+#else
+	if(dir.empty() || dir[dir.size()-1] != '/')
+		dir += '/';
+#endif
+	std::vector<u4> types;
+	std::vector< std::vector<u1> > images;
+	for(size_t i = 0; i < sizeof(g_bundle_files)/sizeof(g_bundle_files[0]); i++) {
+		std::vector<u1> data;
+		if(read_file((dir + g_bundle_files[i].name).c_str(), data) != 0) {
+			if(g_bundle_files[i].type == SECTION_UNIGRAM) {
+				printf("Unigram dictionary not found, %s%s\n", dir.c_str(), g_bundle_files[i].name);
+				return -1;
+			}
+			continue;
+		}
+		types.push_back(g_bundle_files[i].type);
+		images.push_back(std::vector<u1>());
+		images.back().swap(data);
+	}
+	Segmenter_ConfigObj config;
+	if(SegmenterManager::parseconfig((dir + g_config_name).c_str(), &config) == 0) {
+		_csr_bundle_config rec;
+		memset(&rec, 0, sizeof(rec));
+		rec.merge_number_and_ascii = config.merge_number_and_ascii;
+		rec.seperate_number_ascii = config.seperate_number_ascii;
+		rec.compress_space = config.compress_space;
+		rec.omni_segmentation = config.omni_segmentation;
+		memcpy(rec.number_and_ascii_joint, config.number_and_ascii_joint, sizeof(rec.number_and_ascii_joint));
+		rec.normalize = config.normalize;
+		types.push_back(SECTION_CONFIG);
+		images.push_back(std::vector<u1>((u1*)&rec, (u1*)&rec + sizeof(rec)));
+	}
+
+	//layout
+	_csr_bundle_fileheader head;
+	memcpy(head.mg, bundle_head_mgc, 4);
+	head.version = 1;
+	head.reserve = 0;
+	head.section_count = (u4)types.size();
+	head.section_align = SECTION_ALIGN;
+	std::vector<_csr_bundle_section> sections(types.size());
+	u4 offset = sizeof(head) + sizeof(_csr_bundle_section)*(u4)types.size();
+	for(size_t i = 0; i < types.size(); i++) {
+		offset = (offset + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+		sections[i].type = types[i];
+		sections[i].offset = offset;
+		sections[i].size = (u4)images[i].size();
+		sections[i].reserve = 0;
+		offset += sections[i].size;
+	}
+
+	std::string tmp = std::string(target) + ".tmp";
+	FILE* fp = fopen(tmp.c_str(), "wb");
+	if(!fp)
+		return -2;
+	u4 pos = 0;
+	int bad = 0;
+	bad |= fwrite(&head, sizeof(head), 1, fp) != 1;
+	if(!sections.empty())
+		bad |= fwrite(&sections[0], sizeof(_csr_bundle_section), sections.size(), fp) != sections.size();
+	pos = sizeof(head) + sizeof(_csr_bundle_section)*(u4)sections.size();
+	static const u1 zero[SECTION_ALIGN] = {0};
+	for(size_t i = 0; i < sections.size(); i++) {
+		bad |= fwrite(zero, 1, sections[i].offset - pos, fp) != sections[i].offset - pos;
+		if(sections[i].size)
+			bad |= fwrite(&images[i][0], 1, sections[i].size, fp) != sections[i].size;
+		pos = sections[i].offset + sections[i].size;
+	}
+	bad |= fclose(fp) != 0;
+	if(bad) {
+		remove(tmp.c_str());
+		return -2;
+	}
+#ifdef WIN32
+	remove(target); //rename does not replace on win32.
+#endif
+	if(rename(tmp.c_str(), target) != 0) {
+		remove(tmp.c_str());
+		return -2;
+	}
+	return 0;
+}
+
+int DictBundle::isBundle(const char* path)
+{
+	if(!path)
+		return 0;
+#ifdef WIN32
+	struct _stat st;
+	if(_stat(path, &st) != 0)
+		return 0;
+#else
+	struct stat st;
+	if(stat(path, &st) != 0)
+		return 0;
+#endif
+	return (st.st_mode & S_IFMT) == S_IFREG;
+}
+
+int DictBundle::open(const char* filename)
+{
+	if(m_file)
+		csr_munmap_file(m_file);
+	m_base = NULL;
+	m_count = 0;
+	m_file = csr_mmap_file(filename, 0); //real mmap, the sections are used in place.
+	if(!m_file)
+		return -1;
+	csr_offset_t size = csr_mmap_size(m_file);
+	u1* ptr = (u1*)csr_mmap_map(m_file);
+	if(size < sizeof(_csr_bundle_fileheader))
+		return -4;
+	_csr_bundle_fileheader* head_ = (_csr_bundle_fileheader*)ptr;
+	if(strncmp(head_->mg, bundle_head_mgc, 4) != 0)
+		return -3;
+	if(head_->version != 1)
+		return -2;
+	u4 dir_end = sizeof(_csr_bundle_fileheader) + sizeof(_csr_bundle_section)*head_->section_count;
+	if(head_->section_count > 64 || dir_end > size)
+		return -4;
+	_csr_bundle_section* sections = (_csr_bundle_section*)(ptr + sizeof(_csr_bundle_fileheader));
+	for(u4 i = 0; i < head_->section_count; i++) {
+		if(sections[i].offset < dir_end || sections[i].offset > size
+			|| sections[i].size > size - sections[i].offset)
+			return -4;
+	}
+	m_base = ptr;
+	m_count = head_->section_count;
+	return 0;
+}
+
+u1* DictBundle::section(u4 type, csr_offset_t* size)
+{
+	if(!m_base)
+		return NULL;
+	_csr_bundle_section* sections = (_csr_bundle_section*)(m_base + sizeof(_csr_bundle_fileheader));
+	for(u4 i = 0; i < m_count; i++) {
+		if(sections[i].type == type) {
+			if(size)
+				*size = sections[i].size;
+			return m_base + sections[i].offset;
+		}
+	}
+	return NULL;
+}
+
+int DictBundle::getConfig(Segmenter_ConfigObj* config)
+{
+	csr_offset_t size = 0;
+	_csr_bundle_config* rec = (_csr_bundle_config*)section(SECTION_CONFIG, &size);
+	if(!rec || size < offsetof(_csr_bundle_config, normalize))
+		return -1;
+	config->merge_number_and_ascii = rec->merge_number_and_ascii;
+	config->seperate_number_ascii = rec->seperate_number_ascii;
+	config->compress_space = rec->compress_space;
+	config->omni_segmentation = rec->omni_segmentation;
+	memcpy(config->number_and_ascii_joint, rec->number_and_ascii_joint, sizeof(rec->number_and_ascii_joint));
+	config->number_and_ascii_joint[sizeof(rec->number_and_ascii_joint) - 1] = 0;
+	config->compileJoint();
+	config->normalize = size < sizeof(_csr_bundle_config) ? 0 : rec->normalize;
+	return 0;
+}
+
+} /* End of namespace css */
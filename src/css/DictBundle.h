@@ -0,0 +1,89 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_DictBundle_h
+#define css_DictBundle_h
+
+#include "csr_typedefs.h"
+#include "csr_mmap.h"
+
+namespace css {
+
+class Segmenter_ConfigObj;
+
+/*
+A single file image of a dictionary directory, for one-open startup and atomic release.
+
+The layout, every section starts at a page boundary:
+	header		"MMSB", version, section count, page size
+	directory	section count * (type, offset, size)
+	sections	uni.lib, kw.lib, weight.lib, synonyms.dat, thesaurus.lib as is,
+				and mmseg.ini compiled into a fixed record.
+The dictionaries point into the mapping directly, nothing is parsed or copied at load.
+*/
+class DictBundle {
+public:
+	DictBundle();
+	~DictBundle();
+	/**
+	 *  Pack the dictionaries and mmseg.ini of path into target.
+	 *  target is written aside then renamed, a running reader keeps its old mapping.
+	 *  @return 0, ok; -1, uni.lib not found; -2, can not write target
+	 */
+	static int build(const char* path, const char* target);
+	/**
+	 *  @return 1, path is a regular file, taken as a bundle.
+	 */
+	static int isBundle(const char* path);
+	/**
+	 *  Map the bundle.
+	 *  @return 0, ok; -1, can not open; -2, unsupported version; -3, bad format; -4, file broken
+	 */
+	int open(const char* filename);
+	/**
+	 *  @return the section in the mapping, NULL if the bundle has no such section.
+	 */
+	u1* section(u4 type, csr_offset_t* size);
+	/**
+	 *  @return 0, the compiled config is copied into config; -1, no config section
+	 */
+	int getConfig(Segmenter_ConfigObj* config);
+public:
+	enum {
+		SECTION_UNIGRAM = 1,
+		SECTION_KEYWORD = 2,
+		SECTION_WEIGHT = 3,
+		SECTION_SYNONYMS = 4,
+		SECTION_THESAURUS = 5,
+		SECTION_CONFIG = 6,
+		SECTION_T2S = 7
+	};
+	const static u4 SECTION_ALIGN = 4096;	//page size
+protected:
+	csr_mmap_t* m_file;
+	u1* m_base;
+	u4 m_count;
+};
+
+} /* End of namespace css */
+#endif
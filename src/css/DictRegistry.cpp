@@ -0,0 +1,271 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifndef WIN32
+#include <limits.h>
+#endif
+#include "csr_mutex.h"
+#include "DictRegistry.h"
+
+namespace css {
+
+const char g_ngram_unigram_dict_name[] = "uni.lib";
+const char g_kword_unigram_dict_name[] = "kw.lib";
+const char g_wordweight_unigram_dict_name[] = "weight.lib";
+const char g_synonyms_dict_name[] = "synonyms.dat";
+const char g_thesaurus_dict_name[] = "thesaurus.lib";
+const char g_t2s_dict_name[] = "t2s.txt";
+
+static const char* g_dict_names[] = {
+	g_ngram_unigram_dict_name,
+	g_kword_unigram_dict_name,
+	g_wordweight_unigram_dict_name,
+	g_synonyms_dict_name,
+	g_thesaurus_dict_name,
+	g_t2s_dict_name,
+};
+
+typedef std::map<std::string, SharedDicts*> SharedDictsMap;
+
+//never freed, a static SegmenterManager might be destroyed after this unit.
+static SharedDictsMap* g_registry = NULL;
+
+/*
+guards g_registry. Not a static CsrMutex, for the same reason as g_registry: static
+SegmenterManagers of other units may init before this unit's statics are constructed, or
+release after they are destroyed. So it is created on first use and never freed.
+*/
+static CsrMutex& registry_lock()
+{
+	static CsrMutex* lock = new CsrMutex();
+	return *lock;
+}
+//created during static init too, before threads can race on the first use.
+static CsrMutex& g_registry_lock = registry_lock();
+
+/*
+canonical directory + identity of each dictionary file, a missing file counts too.
+*/
+static void make_key(const char* path, std::string& key)
+{
+	char buf[4096];
+	const char** names = g_dict_names;
+	size_t count = sizeof(g_dict_names)/sizeof(g_dict_names[0]);
+	size_t nLen = strlen(path);
+#ifdef WIN32
+	if(_fullpath(buf, path, sizeof(buf)))
+		key = buf;
+#else
+	if(realpath(path, buf))
+		key = buf;
+#endif
+	else
+		key = path;
+	//a bundle is a single file.
+	const char* bundle_names[1] = { path };
+	if(DictBundle::isBundle(path)) {
+		names = bundle_names;
+		count = 1;
+		nLen = 0;
+	}
+
+	char fname[1024];
+	char ident[128];
+	for(size_t i = 0; i < count; i++) {
+		size_t sl = strlen(names[i]);
+		if(nLen + sl >= sizeof(fname))
+			break;
+		memcpy(fname, path, nLen);
+		memcpy(&fname[nLen], names[i], sl + 1);
+#ifdef WIN32
+		struct _stat st;
+		if(_stat(fname, &st) != 0)
+#else
+		struct stat st;
+		if(stat(fname, &st) != 0)
+#endif
+		{
+			key += "|-";
+			continue;
+		}
+		sprintf(ident, "|%lu:%lu:%lu:%lu", (unsigned long)st.st_dev,
+			(unsigned long)st.st_ino, (unsigned long)st.st_size, (unsigned long)st.st_mtime);
+		key += ident;
+	}
+}
+
+/*
+@param path dictionary directory, end with '/'
+@return 0, ok
+*/
+int SharedDicts::load(const char* path)
+{
+	if(DictBundle::isBundle(path))
+		return loadBundle(path);
+	char buf[1024];
+	int nLen = (int)strlen(path);
+	if(nLen + 32 >= (int)sizeof(buf))
+		return -1;
+	memcpy(buf, path, nLen);
+
+	int nRet = 0;
+	memcpy(&buf[nLen],g_ngram_unigram_dict_name,strlen(g_ngram_unigram_dict_name));
+	buf[nLen+strlen(g_ngram_unigram_dict_name)] = 0;
+	nRet = m_uni.load(buf);
+	if(nRet!=0){
+		printf("Unigram dictionary load Error(%d), %s\n", nRet, buf);
+		return nRet;
+	}
+	//no needs to care kwformat
+	memcpy(&buf[nLen],g_kword_unigram_dict_name,strlen(g_kword_unigram_dict_name));
+	buf[nLen+strlen(g_kword_unigram_dict_name)] = 0;
+	nRet = m_kw.load(buf);
+	if(nRet!=0 && nRet!=-1 ){
+		//m_kw not exist or format error.
+		printf("Keyword dictionary load Error\n");
+		return nRet;
+	}
+
+	//try to load weight dict
+	memcpy(&buf[nLen],g_wordweight_unigram_dict_name,strlen(g_wordweight_unigram_dict_name));
+	buf[nLen+strlen(g_wordweight_unigram_dict_name)] = 0;
+	nRet = m_weight.load(buf);
+	if(nRet!=0 && nRet!=-1 ){
+		//m_kw not exist or format error.
+		printf("Keyword dictionary load Error\n");
+		return nRet;
+	}
+
+	memcpy(&buf[nLen],g_synonyms_dict_name,strlen(g_synonyms_dict_name));
+	buf[nLen+strlen(g_synonyms_dict_name)] = 0;
+	//load g_synonyms_dict_name, we do not care the load in right or not
+	nRet = m_sym.load(buf);
+	if(nRet!=0 && nRet != -1){
+		printf("Synonyms dictionary format Error\n");
+	}
+
+	memcpy(&buf[nLen],g_thesaurus_dict_name,strlen(g_thesaurus_dict_name));
+	buf[nLen+strlen(g_thesaurus_dict_name)] = 0;
+	//load g_synonyms_dict_name, we do not care the load in right or not
+	nRet = m_thesaurus.load(buf);
+	if(nRet!=0 && nRet != -1){
+		printf("Thesaurus dictionary format Error\n");
+	}
+
+	memcpy(&buf[nLen],g_t2s_dict_name,strlen(g_t2s_dict_name));
+	buf[nLen+strlen(g_t2s_dict_name)] = 0;
+	//only used by normalize_t2s
+	nRet = m_normalizer.load(buf);
+	if(nRet!=0 && nRet != -1){
+		printf("T2S table format Error\n");
+	}
+	return 0;
+}
+
+/*
+the same error codes as load, the optional sections are ignored if broken.
+*/
+int SharedDicts::loadBundle(const char* filename)
+{
+	int nRet = m_bundle.open(filename);
+	if(nRet != 0) {
+		printf("Dictionary bundle load Error(%d), %s\n", nRet, filename);
+		return nRet;
+	}
+	csr_offset_t size = 0;
+	u1* ptr = m_bundle.section(DictBundle::SECTION_UNIGRAM, &size);
+	if(!ptr) {
+		printf("Unigram dictionary not in bundle, %s\n", filename);
+		return -1;
+	}
+	m_uni.attach(ptr, size);
+	if((ptr = m_bundle.section(DictBundle::SECTION_KEYWORD, &size)))
+		m_kw.attach(ptr, size);
+	if((ptr = m_bundle.section(DictBundle::SECTION_WEIGHT, &size)))
+		m_weight.attach(ptr, size);
+	if((ptr = m_bundle.section(DictBundle::SECTION_SYNONYMS, &size))
+		&& m_sym.attach(ptr, size) != 0)
+		printf("Synonyms dictionary format Error\n");
+	if((ptr = m_bundle.section(DictBundle::SECTION_THESAURUS, &size))
+		&& m_thesaurus.attach(ptr, size) != 0)
+		printf("Thesaurus dictionary format Error\n");
+	if((ptr = m_bundle.section(DictBundle::SECTION_T2S, &size))
+		&& m_normalizer.attach(ptr, (u4)size) != 0)
+		printf("T2S table format Error\n");
+	m_has_config = m_bundle.getConfig(&m_config) == 0;
+	return 0;
+}
+
+SharedDicts* DictRegistry::acquire(const char* path, int* pRet)
+{
+	std::string key;
+	make_key(path, key);
+
+	registry_lock().lock();
+	if(!g_registry)
+		g_registry = new SharedDictsMap();
+	SharedDictsMap::iterator it = g_registry->find(key);
+	if(it != g_registry->end()) {
+		SharedDicts* dicts = it->second;
+		dicts->m_refcount++;
+		registry_lock().unlock();
+		return dicts;
+	}
+	//load under the lock, a concurrent init of the same path waits and shares the result.
+	SharedDicts* dicts = new SharedDicts();
+	int nRet = dicts->load(path);
+	if(nRet != 0) {
+		registry_lock().unlock();
+		delete dicts;
+		if(pRet)
+			*pRet = nRet;
+		return NULL;
+	}
+	dicts->m_key = key;
+	dicts->m_refcount = 1;
+	(*g_registry)[key] = dicts;
+	registry_lock().unlock();
+	return dicts;
+}
+
+void DictRegistry::release(SharedDicts* dicts)
+{
+	if(!dicts)
+		return;
+	registry_lock().lock();
+	if(--dicts->m_refcount > 0) {
+		registry_lock().unlock();
+		return;
+	}
+	g_registry->erase(dicts->m_key);
+	registry_lock().unlock();
+	delete dicts;
+}
+
+} /* End of namespace css */
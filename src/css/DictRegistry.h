@@ -0,0 +1,89 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_DictRegistry_h
+#define css_DictRegistry_h
+
+#include <string>
+#include "UnigramDict.h"
+#include "SynonymsDict.h"
+#include "ThesaurusDict.h"
+#include "DictBundle.h"
+#include "Segmenter.h"
+
+namespace css {
+
+extern const char g_ngram_unigram_dict_name[];
+extern const char g_kword_unigram_dict_name[];
+extern const char g_wordweight_unigram_dict_name[];
+extern const char g_synonyms_dict_name[];
+extern const char g_thesaurus_dict_name[];
+extern const char g_t2s_dict_name[];
+extern const char g_config_name[];
+
+/*
+The dictionaries of a path, shared by every SegmenterManager of the process.
+They are read-only once loaded.
+*/
+class SharedDicts {
+public:
+	DictBundle m_bundle;	//the dictionaries point into it, if loaded from a bundle.
+	Segmenter_ConfigObj m_config;	//the compiled config of the bundle
+	u1 m_has_config;
+	UnigramDict m_uni;
+	UnigramDict m_kw;
+	UnigramDict m_weight;
+	SynonymsDict m_sym;
+	ThesaurusDict m_thesaurus;
+	CharNormalizer m_normalizer;	//with the t2s table, if any
+protected:
+	friend class DictRegistry;
+	SharedDicts():m_has_config(0), m_refcount(0) {}
+	int load(const char* path);
+	int loadBundle(const char* filename);
+	std::string m_key;
+	int m_refcount;
+};
+
+/*
+Process-wide registry of SharedDicts, reference counted.
+The key is the canonical path of the dictionary directory (or bundle), plus the
+identity (device, inode, size, mtime) of each dictionary file; a replaced file gets
+a new instance, while the managers still holding the old one keep using it.
+*/
+class DictRegistry {
+public:
+	/**
+	 *  @param path the dictionary directory, end with '/'; or a bundle file.
+	 *  @param pRet set to the error code of load, if failed.
+	 *  @return the dictionaries, NULL if failed.
+	 */
+	static SharedDicts* acquire(const char* path, int* pRet);
+	/**
+	 *  Drop a reference, the dictionaries are unloaded by the last one.
+	 */
+	static void release(SharedDicts* dicts);
+};
+
+} /* End of namespace css */
+#endif
@@ -0,0 +1,151 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <string.h>
+#include <algorithm>
+#include "KeywordExtractor.h"
+#include "Utf8_16.h"
+
+namespace css {
+	using namespace csr;
+
+KeywordExtractor::KeywordExtractor()
+{
+	m_table.resize(DEFAULT_TABLE_SIZE);
+	memset(&m_table[0], 0, sizeof(Slot)*DEFAULT_TABLE_SIZE);
+	m_mask = DEFAULT_TABLE_SIZE - 1;
+	m_tagger = ChineseCharTagger::Get();
+}
+
+KeywordExtractor::~KeywordExtractor()
+{
+}
+
+KeywordExtractor::Slot* KeywordExtractor::lookup(const u1* token, u2 length, u4 hash)
+{
+	u4 idx = hash & m_mask;
+	while(1) {
+		Slot* slot = &m_table[idx];
+		if(!slot->token)
+			return slot;
+		if(slot->hash == hash && slot->length == length
+			&& memcmp(slot->token, token, length) == 0)
+			return slot;
+		idx = (idx + 1) & m_mask;
+	}
+	return NULL;
+}
+
+void KeywordExtractor::grow()
+{
+	std::vector<Slot> old;
+	old.swap(m_table);
+	u4 size = (m_mask + 1) * 2;
+	m_table.resize(size);
+	memset(&m_table[0], 0, sizeof(Slot)*size);
+	m_mask = size - 1;
+	for(size_t i = 0; i < m_used.size(); i++) {
+		Slot& item = old[m_used[i]];
+		Slot* slot = lookup(item.token, item.length, item.hash);
+		*slot = item;
+		m_used[i] = (u4)(slot - &m_table[0]);
+	}
+}
+
+void KeywordExtractor::clear()
+{
+	for(size_t i = 0; i < m_used.size(); i++)
+		m_table[m_used[i]].token = NULL;
+	m_used.clear();
+}
+
+int KeywordExtractor::extract(Segmenter* seg, u1* buf, u4 length, KeywordItem* result, int topk)
+{
+	clear();
+	if(topk <= 0)
+		return 0;
+	seg->setBuffer(buf, length);
+	u4 order = 0;
+	while(1) {
+		u2 len = 0, symlen = 0;
+		const u1* tok = seg->peekToken(len, symlen);
+		if(!tok || !*tok || !len)
+			break;
+		seg->popToken(len);
+		//skip spaces, symbols and separators.
+		u2 clen = 0;
+		int iCode = csrUTF8Decode(tok, clen);
+		if(iCode <= 0x20)
+			continue;
+		u2 tag = m_tagger->tagUnicode(iCode, 1);
+		tag = (tag&0x3F) + 'a' -1;
+		if(tag == 'w' || tag == 's')
+			continue;
+
+		u4 hash = hashOf(tok, symlen);
+		Slot* slot = lookup(tok, symlen, hash);
+		if(!slot->token) {
+			if((m_used.size() + 1)*2 > m_mask + 1) {
+				grow(); //keep load factor under 0.5
+				slot = lookup(tok, symlen, hash);
+			}
+			slot->token = tok;
+			slot->length = symlen;
+			slot->hash = hash;
+			slot->tf = 0;
+			slot->weight = seg->getWordWeight((u1*)tok, symlen);
+			slot->first = order++;
+			m_used.push_back((u4)(slot - &m_table[0]));
+		}
+		slot->tf++;
+	}
+
+	//bounded min-heap, the top of heap is the least one of current top K.
+	m_heap.clear();
+	ScoreGreater cmp;
+	for(size_t i = 0; i < m_used.size(); i++) {
+		Slot* slot = &m_table[m_used[i]];
+		if((int)m_heap.size() < topk) {
+			m_heap.push_back(slot);
+			std::push_heap(m_heap.begin(), m_heap.end(), cmp);
+		}else
+		if(scoreLess(m_heap[0], slot)) {
+			std::pop_heap(m_heap.begin(), m_heap.end(), cmp);
+			m_heap.back() = slot;
+			std::push_heap(m_heap.begin(), m_heap.end(), cmp);
+		}
+	}
+	std::sort_heap(m_heap.begin(), m_heap.end(), cmp);
+	int count = (int)m_heap.size();
+	for(int i = 0; i < count; i++) {
+		Slot* slot = m_heap[i];
+		result[i].token = slot->token;
+		result[i].length = slot->length;
+		result[i].tf = slot->tf;
+		result[i].weight = slot->weight;
+		result[i].score = slot->tf * slot->weight;
+	}
+	return count;
+}
+
+} /* End of namespace css */
@@ -0,0 +1,102 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_KeywordExtractor_h
+#define css_KeywordExtractor_h
+
+#include <vector>
+#include "csr_typedefs.h"
+#include "Segmenter.h"
+
+namespace css {
+
+struct KeywordItem {
+	const u1* token; //point into the document, or the synonyms dictionary.
+	u2 length;
+	u4 tf;
+	u4 weight;
+	u4 score; // tf * weight
+};
+
+/*
+Top-K keyword extraction.
+- segment the document, accumulate term frequency in an open-addressing table keyed by token span.
+- the word weight is looked up once per distinct token.
+- the top K is picked by a bounded min-heap.
+A extractor can be reused for many documents, but is NOT thread-safe, use one per thread.
+*/
+class KeywordExtractor {
+public:
+	KeywordExtractor();
+	~KeywordExtractor();
+
+	/**
+	 *  Segment buf with seg, and fill the top K keywords into result, order by score desc.
+	 *  The tokens point into buf (or the synonyms dictionary), buf should be kept alive while using the result.
+	 *  @return the count of keywords filled.
+	 */
+	int extract(Segmenter* seg, u1* buf, u4 length, KeywordItem* result, int topk);
+
+protected:
+	struct Slot {
+		const u1* token;
+		u2 length;
+		u4 hash;
+		u4 tf;
+		u4 weight;
+		u4 first; //the order of first occurrence, used to break the tie.
+	};
+	Slot* lookup(const u1* token, u2 length, u4 hash);
+	void grow();
+	void clear();
+	static inline u4 hashOf(const u1* token, u2 length) {
+		u4 h = 2166136261U; //FNV-1a
+		for(u2 i = 0; i < length; i++) {
+			h ^= token[i];
+			h *= 16777619U;
+		}
+		return h;
+	}
+	static inline bool scoreLess(const Slot* a, const Slot* b) {
+		u4 sa = a->tf * a->weight;
+		u4 sb = b->tf * b->weight;
+		if(sa != sb)
+			return sa < sb;
+		return a->first > b->first;
+	}
+	struct ScoreGreater {
+		bool operator()(const Slot* a, const Slot* b) const {
+			return scoreLess(b, a);
+		}
+	};
+protected:
+	std::vector<Slot> m_table;
+	std::vector<u4> m_used; //index of used slots, only these are cleared between documents.
+	std::vector<Slot*> m_heap;
+	u4 m_mask;
+	ChineseCharTaggerImpl* m_tagger;
+	const static u4 DEFAULT_TABLE_SIZE = 4096;
+};
+
+} /* End of namespace css */
+#endif
@@ -0,0 +1,282 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <string.h>
+#include "SegmentExecutor.h"
+#include "SegmentPkg.h"
+
+namespace css {
+
+SegmentJob::SegmentJob()
+	:m_buffer(NULL), m_length(0), m_callback(NULL), m_data(NULL),
+	m_remains(0), m_done(0)
+{
+	pthread_mutex_init(&m_lock, NULL);
+	pthread_cond_init(&m_cond, NULL);
+}
+
+SegmentJob::~SegmentJob()
+{
+	pthread_cond_destroy(&m_cond);
+	pthread_mutex_destroy(&m_lock);
+}
+
+void SegmentJob::wait()
+{
+	pthread_mutex_lock(&m_lock);
+	while(!m_done)
+		pthread_cond_wait(&m_cond, &m_lock);
+	pthread_mutex_unlock(&m_lock);
+}
+
+int SegmentJob::isDone()
+{
+	pthread_mutex_lock(&m_lock);
+	int done = m_done;
+	pthread_mutex_unlock(&m_lock);
+	return done;
+}
+
+SegmentExecutor::SegmentExecutor()
+	:m_pending(0), m_next(0), m_stop(0), m_split_size(DEFAULT_SPLIT_SIZE), m_config(NULL)
+{
+	pthread_mutex_init(&m_idle_lock, NULL);
+	pthread_cond_init(&m_idle_cond, NULL);
+}
+
+SegmentExecutor::~SegmentExecutor()
+{
+	shutdown();
+	pthread_cond_destroy(&m_idle_cond);
+	pthread_mutex_destroy(&m_idle_lock);
+}
+
+int SegmentExecutor::init(SegmenterManager* mgr, int threads, u4 split_size)
+{
+	if(!m_workers.empty() || threads <= 0)
+		return -1;
+	m_split_size = split_size ? split_size : DEFAULT_SPLIT_SIZE;
+	m_stop = 0;
+	//segmenters are taken here, getSegmenter is not thread-safe.
+	for(int i = 0; i < threads; i++) {
+		Worker* worker = new Worker();
+		worker->owner = this;
+		worker->index = i;
+		worker->seg = mgr->getSegmenter(false);
+		pthread_mutex_init(&worker->lock, NULL);
+		m_workers.push_back(worker);
+	}
+	m_config = m_workers[0]->seg->m_config;
+	for(int i = 0; i < threads; i++)
+		pthread_create(&m_workers[i]->tid, NULL, workerMain, m_workers[i]);
+	return 0;
+}
+
+int SegmentExecutor::submit(SegmentJob* job)
+{
+	if(m_workers.empty())
+		return -1;
+	//cut into pieces at line boundaries, or separators.
+	std::vector<Task> tasks;
+	u4 begin = 0;
+	while(begin < job->m_length) {
+		u4 end = splitEnd(job->m_buffer, job->m_length, begin);
+		Task task;
+		task.job = job;
+		task.begin = begin;
+		task.end = end;
+		task.piece = (u4)tasks.size();
+		tasks.push_back(task);
+		begin = end;
+	}
+	job->m_offsets.clear();
+	job->m_pieces.clear();
+	job->m_pieces.resize(tasks.size());
+	job->m_remains = (int)tasks.size();
+	job->m_done = 0;
+	if(tasks.empty()) {
+		finishJob(job);
+		return 0;
+	}
+
+	size_t num = m_workers.size();
+	pthread_mutex_lock(&m_idle_lock);
+	u4 first = m_next;
+	m_next += (u4)tasks.size();
+	pthread_mutex_unlock(&m_idle_lock);
+	for(size_t i = 0; i < tasks.size(); i++) {
+		Worker* worker = m_workers[(first + i) % num];
+		pthread_mutex_lock(&worker->lock);
+		worker->tasks.push_back(tasks[i]);
+		pthread_mutex_unlock(&worker->lock);
+	}
+	pthread_mutex_lock(&m_idle_lock);
+	m_pending += (u4)tasks.size();
+	if(tasks.size() == 1)
+		pthread_cond_signal(&m_idle_cond);
+	else
+		pthread_cond_broadcast(&m_idle_cond);
+	pthread_mutex_unlock(&m_idle_lock);
+	return 0;
+}
+
+u4 SegmentExecutor::splitEnd(const u1* buf, u4 length, u4 begin)
+{
+	if(length - begin <= m_split_size)
+		return length;
+	u4 from = begin + m_split_size;
+	u4 limit = (length - from > m_split_size) ? from + m_split_size : length;
+	const u1* nl = (const u1*)memchr(&buf[from], '\n', limit - from);
+	if(nl)
+		return (u4)(nl - buf) + 1;
+	//a long line, take the first separator tagged in the same span.
+	SegmentPkg pkg;
+	std::vector<u1> tags(limit - from + 1, 0);
+	pkg.tagData((const char*)&buf[from], &tags[0], (int)(limit - from), 0);
+	for(size_t i = 0; i < pkg.m_wTagList.size(); i++) {
+		u4 end = SegmentPkg::separatorCut(buf, length, from + (u4)pkg.m_wTagList[i], m_config);
+		if(end)
+			return end;
+	}
+	nl = (const u1*)memchr(&buf[limit], '\n', length - limit);
+	if(nl)
+		return (u4)(nl - buf) + 1;
+	return length;
+}
+
+void SegmentExecutor::shutdown()
+{
+	if(m_workers.empty())
+		return;
+	pthread_mutex_lock(&m_idle_lock);
+	m_stop = 1;
+	pthread_cond_broadcast(&m_idle_cond);
+	pthread_mutex_unlock(&m_idle_lock);
+	//a running worker might still steal from the others, join all first.
+	for(size_t i = 0; i < m_workers.size(); i++)
+		pthread_join(m_workers[i]->tid, NULL);
+	for(size_t i = 0; i < m_workers.size(); i++) {
+		Worker* worker = m_workers[i];
+		pthread_mutex_destroy(&worker->lock);
+		delete worker->seg;
+		delete worker;
+	}
+	m_workers.clear();
+}
+
+/*
+@return 1, got a task
+*/
+int SegmentExecutor::takeTask(Worker* worker, Task& task)
+{
+	int got = 0;
+	pthread_mutex_lock(&worker->lock);
+	if(!worker->tasks.empty()) {
+		task = worker->tasks.back();
+		worker->tasks.pop_back();
+		got = 1;
+	}
+	pthread_mutex_unlock(&worker->lock);
+	//steal from others
+	size_t num = m_workers.size();
+	for(size_t i = 1; !got && i < num; i++) {
+		Worker* victim = m_workers[(worker->index + i) % num];
+		pthread_mutex_lock(&victim->lock);
+		if(!victim->tasks.empty()) {
+			task = victim->tasks.front();
+			victim->tasks.pop_front();
+			got = 1;
+		}
+		pthread_mutex_unlock(&victim->lock);
+	}
+	if(got) {
+		pthread_mutex_lock(&m_idle_lock);
+		m_pending--;
+		pthread_mutex_unlock(&m_idle_lock);
+	}
+	return got;
+}
+
+void SegmentExecutor::runTask(Worker* worker, Task& task)
+{
+	SegmentJob* job = task.job;
+	std::vector<u4>& offsets = job->m_pieces[task.piece];
+	worker->seg->segmentOffsets(&job->m_buffer[task.begin], task.end - task.begin, offsets);
+	if(task.begin) {
+		for(size_t i = 0; i < offsets.size(); i++)
+			offsets[i] += task.begin;
+	}
+	pthread_mutex_lock(&job->m_lock);
+	int remains = --job->m_remains;
+	pthread_mutex_unlock(&job->m_lock);
+	if(!remains)
+		finishJob(job);
+}
+
+void SegmentExecutor::finishJob(SegmentJob* job)
+{
+	//stitch the pieces back in order.
+	if(job->m_pieces.size() == 1)
+		job->m_offsets.swap(job->m_pieces[0]);
+	else{
+		size_t total = 0;
+		for(size_t i = 0; i < job->m_pieces.size(); i++)
+			total += job->m_pieces[i].size();
+		job->m_offsets.reserve(total);
+		for(size_t i = 0; i < job->m_pieces.size(); i++)
+			job->m_offsets.insert(job->m_offsets.end(), job->m_pieces[i].begin(), job->m_pieces[i].end());
+	}
+	job->m_pieces.clear();
+	//the job might be deleted once it's done, read the callback first.
+	SegmentCallback* callback = job->m_callback;
+	pthread_mutex_lock(&job->m_lock);
+	job->m_done = 1;
+	if(!callback)
+		pthread_cond_broadcast(&job->m_cond);
+	pthread_mutex_unlock(&job->m_lock);
+	if(callback)
+		callback->onComplete(job);
+}
+
+void* SegmentExecutor::workerMain(void* arg)
+{
+	Worker* worker = (Worker*)arg;
+	SegmentExecutor* owner = worker->owner;
+	Task task;
+	while(1) {
+		if(owner->takeTask(worker, task)) {
+			owner->runTask(worker, task);
+			continue;
+		}
+		pthread_mutex_lock(&owner->m_idle_lock);
+		while(!owner->m_pending && !owner->m_stop)
+			pthread_cond_wait(&owner->m_idle_cond, &owner->m_idle_lock);
+		int stop = owner->m_stop && !owner->m_pending;
+		pthread_mutex_unlock(&owner->m_idle_lock);
+		if(stop)
+			break;
+	}
+	return NULL;
+}
+
+} /* End of namespace css */
@@ -0,0 +1,139 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_SegmentExecutor_h
+#define css_SegmentExecutor_h
+
+#include <vector>
+#include <deque>
+#include <pthread.h>
+#include "csr_typedefs.h"
+#include "SegmenterManager.h"
+
+namespace css {
+
+class SegmentJob;
+
+class SegmentCallback {
+public:
+	virtual ~SegmentCallback() {}
+	/**
+	 *  Called in the worker thread, once the job is done.
+	 *  The job can be deleted here. A job with callback can NOT be waited.
+	 */
+	virtual void onComplete(SegmentJob* job) = 0;
+};
+
+/*
+A document submitted to SegmentExecutor, owned by the caller.
+Set m_buffer/m_length (and optional m_callback/m_data) before submit, and keep the buffer
+alive until the job is done. The buffer should be NUL terminated, as Segmenter::setBuffer.
+*/
+class SegmentJob {
+public:
+	SegmentJob();
+	~SegmentJob();
+	/**
+	 *  Block until the job is done.
+	 */
+	void wait();
+	int isDone();
+public:
+	u1* m_buffer;
+	u4 m_length;
+	SegmentCallback* m_callback;
+	void* m_data;
+	std::vector<u4> m_offsets; //the result, (start, end) byte offsets of each token.
+protected:
+	friend class SegmentExecutor;
+	std::vector< std::vector<u4> > m_pieces; //result of each piece, stitched when done.
+	int m_remains;
+	int m_done;
+	pthread_mutex_t m_lock;
+	pthread_cond_t m_cond;
+};
+
+/*
+Asynchronous segmentation on a work-stealing thread pool.
+- each worker owns one Segmenter, and a task deque.
+- a large document is split at line boundaries into pieces, which are spread over the deques.
+  MMSEG never makes a decision across a line, so the stitched result is the same as a whole.
+  A long line is split at a separator instead, see SegmentPkg::separatorCut.
+- a worker pops its own deque from the back, and steals from the front of others when empty.
+*/
+class SegmentExecutor {
+public:
+	SegmentExecutor();
+	~SegmentExecutor();
+	/**
+	 *  @param split_size documents larger than this are split into pieces.
+	 *  @return 0, ok
+	 */
+	int init(SegmenterManager* mgr, int threads, u4 split_size = DEFAULT_SPLIT_SIZE);
+	/**
+	 *  Queue the job, the result is delivered by job->wait() or job->m_callback.
+	 *  @return 0, ok
+	 */
+	int submit(SegmentJob* job);
+	/**
+	 *  Finish all queued jobs, then stop the workers.
+	 */
+	void shutdown();
+public:
+	const static u4 DEFAULT_SPLIT_SIZE = 64*1024;
+protected:
+	struct Task {
+		SegmentJob* job;
+		u4 begin;
+		u4 end;
+		u4 piece;
+	};
+	struct Worker {
+		SegmentExecutor* owner;
+		int index;
+		pthread_t tid;
+		Segmenter* seg;
+		std::deque<Task> tasks;
+		pthread_mutex_t lock;
+	};
+	static void* workerMain(void* arg);
+	/**
+	 *  @return the end of the piece start at begin.
+	 */
+	u4 splitEnd(const u1* buf, u4 length, u4 begin);
+	int takeTask(Worker* worker, Task& task);
+	void runTask(Worker* worker, Task& task);
+	void finishJob(SegmentJob* job);
+protected:
+	std::vector<Worker*> m_workers;
+	pthread_mutex_t m_idle_lock;
+	pthread_cond_t m_idle_cond;
+	u4 m_pending;	//tasks queued, protected by m_idle_lock
+	u4 m_next;		//round robin of submit, protected by m_idle_lock
+	u1 m_stop;
+	u4 m_split_size;
+	const Segmenter_ConfigObj* m_config;	//of the segmenters
+};
+
+} /* End of namespace css */
+#endif
@@ -0,0 +1,224 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <string.h>
+#include "SegmentPipeline.h"
+#include "Segmenter.h"
+
+namespace css {
+
+SegmentPipeline::SegmentPipeline()
+	:m_head(0), m_tail(0), m_count(0), m_done(0), m_stop(0), m_taken(0), m_running(0),
+	m_source(NULL), m_config(NULL), m_eof(0), m_carry_pos(0), m_produced(0), m_offset(0)
+{
+	pthread_mutex_init(&m_lock, NULL);
+	pthread_cond_init(&m_cond, NULL);
+}
+
+SegmentPipeline::~SegmentPipeline()
+{
+	stop();
+	pthread_cond_destroy(&m_cond);
+	pthread_mutex_destroy(&m_lock);
+}
+
+int SegmentPipeline::start(PipelineSource* source, const Segmenter_ConfigObj* config, int encoding)
+{
+	stop();
+	m_source = source;
+	m_config = config;
+	m_transcoder.reset(encoding);
+	m_eof = 0;
+	m_carry.clear();
+	m_carry_pos = 0;
+	m_produced = 0;
+	m_offset = 0;
+	m_head = m_tail = m_count = 0;
+	m_done = m_stop = m_taken = 0;
+	if(pthread_create(&m_tid, NULL, producerMain, this) != 0)
+		return -1;
+	m_running = 1;
+	return 0;
+}
+
+void SegmentPipeline::stop()
+{
+	if(!m_running)
+		return;
+	pthread_mutex_lock(&m_lock);
+	m_stop = 1;
+	pthread_cond_broadcast(&m_cond);
+	pthread_mutex_unlock(&m_lock);
+	pthread_join(m_tid, NULL);
+	m_running = 0;
+}
+
+SegmentPkg* SegmentPipeline::next()
+{
+	if(!m_running)
+		return NULL;
+	pthread_mutex_lock(&m_lock);
+	if(m_taken) {
+		//give the last package back to the producer.
+		m_head = (m_head + 1) % PIPELINE_DEPTH;
+		m_count--;
+		m_taken = 0;
+		pthread_cond_broadcast(&m_cond);
+	}
+	while(!m_count && !m_done)
+		pthread_cond_wait(&m_cond, &m_lock);
+	SegmentPkg* pkg = NULL;
+	if(m_count) {
+		m_taken = 1;
+		pkg = &m_slots[m_head].pkg;
+		m_offset = m_slots[m_head].offset;
+	}
+	pthread_mutex_unlock(&m_lock);
+	return pkg;
+}
+
+void* SegmentPipeline::producerMain(void* arg)
+{
+	((SegmentPipeline*)arg)->produce();
+	return NULL;
+}
+
+void SegmentPipeline::produce()
+{
+	while(1) {
+		pthread_mutex_lock(&m_lock);
+		while(m_count == PIPELINE_DEPTH && !m_stop)
+			pthread_cond_wait(&m_cond, &m_lock);
+		u1 bStop = m_stop;
+		pthread_mutex_unlock(&m_lock);
+		if(bStop)
+			break;
+		//the slot is not seen by the consumer till m_count counts it.
+		Slot* slot = &m_slots[m_tail];
+		SegmentPkg* pkg = &slot->pkg;
+		int more = fill(pkg);
+		u4 length = (u4)pkg->m_length;
+		if(more && length) {
+			u4 n = cut(pkg, length / 2);
+			if(!n)
+				n = cut(pkg, 0);
+			if(n < length) {
+				m_carry.insert(m_carry.begin() + m_carry_pos, (const u1*)&pkg->m_buf[n],
+					(const u1*)&pkg->m_buf[length]);
+				pkg->m_length = (int)n;
+			}
+		}
+		if(pkg->m_length) {
+			((char*)pkg->m_buf)[pkg->m_length] = 0;
+			slot->offset = m_produced;
+			m_produced += pkg->m_length;
+			pthread_mutex_lock(&m_lock);
+			m_tail = (m_tail + 1) % PIPELINE_DEPTH;
+			m_count++;
+			pthread_cond_broadcast(&m_cond);
+			pthread_mutex_unlock(&m_lock);
+		}
+		if(!more)
+			break;
+	}
+	pthread_mutex_lock(&m_lock);
+	m_done = 1;
+	pthread_cond_broadcast(&m_cond);
+	pthread_mutex_unlock(&m_lock);
+}
+
+int SegmentPipeline::fill(SegmentPkg* pkg)
+{
+	pkg->setSize(SegmentPkg::DEFAULT_PACKAGE_LENGTH);
+	pkg->clear();
+	while(1) {
+		//feedData wants a byte more than the data, and the NUL.
+		u4 room = (u4)(pkg->m_size - pkg->m_length - 2);
+		u4 avail = (u4)m_carry.size() - m_carry_pos;
+		if(avail) {
+			u4 n = avail < room ? avail : room;
+			if(n) {
+				pkg->feedData((const char*)&m_carry[m_carry_pos], (int)n);
+				m_carry_pos += n;
+			}
+			if(n == room)
+				break;
+		}
+		m_carry.clear();
+		m_carry_pos = 0;
+		if(m_eof)
+			break;
+		if(m_transcoder.encoding() == Transcoder::ENC_UTF8) {
+			m_carry.resize(READ_SIZE);
+			int n = m_source->read((char*)&m_carry[0], READ_SIZE);
+			m_carry.resize(n > 0 ? n : 0);
+			if(n <= 0)
+				m_eof = 1;
+		}else{
+			char buf[READ_SIZE];
+			int n = m_source->read(buf, READ_SIZE);
+			if(n > 0)
+				m_transcoder.feed((const u1*)buf, (u4)n, m_carry);
+			else{
+				m_transcoder.finish(m_carry);
+				m_eof = 1;
+			}
+		}
+	}
+	return !m_eof || m_carry_pos < m_carry.size();
+}
+
+u4 SegmentPipeline::cut(SegmentPkg* pkg, u4 from)
+{
+	const u1* buf = (const u1*)pkg->m_buf;
+	u4 length = (u4)pkg->m_length;
+	//MMSEG never makes a decision across a line.
+	for(u4 p = length; p > from; p--) {
+		if(buf[p - 1] == '\n')
+			return p;
+	}
+	//nor across a separator, mostly.
+	for(size_t i = pkg->m_wTagList.size(); i > 0; i--) {
+		u4 pos = (u4)pkg->m_wTagList[i - 1];
+		if(pos < from)
+			break;
+		u4 n = SegmentPkg::separatorCut(buf, length, pos, m_config);
+		if(n)
+			return n;
+	}
+	if(from)
+		return 0;
+	//no place to cut, keep the last char whole at least.
+	u4 p = length;
+	while(p > 0 && length - p < 3 && (buf[p - 1] & 0xC0) == 0x80)
+		p--;
+	if(p > 0 && buf[p - 1] >= 0xC0) {
+		u1 v = buf[p - 1];
+		u4 need = (v & 0xE0) == 0xC0 ? 2 : ((v & 0xF0) == 0xE0 ? 3 : 4);
+		if(length - (p - 1) < need)
+			return p - 1 ? p - 1 : length;
+	}
+	return length;
+}
+
+} /* End of namespace css */
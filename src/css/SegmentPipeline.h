@@ -0,0 +1,142 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_SegmentPipeline_h
+#define css_SegmentPipeline_h
+
+#include <vector>
+#include <istream>
+#include <pthread.h>
+#include "csr_typedefs.h"
+#include "SegmentPkg.h"
+#include "Transcoder.h"
+
+namespace css {
+
+class Segmenter_ConfigObj;
+
+/*
+The stream a SegmentPipeline reads, called in the producer thread.
+*/
+class PipelineSource {
+public:
+	virtual ~PipelineSource() {}
+	/**
+	 *  @return bytes read into buf, 0 at the end of the stream.
+	 */
+	virtual int read(char* buf, int size) = 0;
+};
+
+class StreamPipelineSource : public PipelineSource {
+public:
+	StreamPipelineSource(std::istream& is):m_is(is) {}
+	virtual int read(char* buf, int size) {
+		m_is.read(buf, size);
+		return (int)m_is.gcount();
+	}
+protected:
+	std::istream& m_is;
+};
+
+/*
+Segments a long stream in two stages, on two cores.
+- the producer thread reads the stream, converts it to UTF-8, and feeds and tags it into
+  SegmentPkg packages, while the caller segments the packages before.
+- a package ends after its last line, or else its last separator ('w' char) not joint with
+  numbers and ascii, so it is segmented alone as a part of the whole text. A package without
+  either is cut at a char, words across that cut are lost.
+- packages are handed over by a single-producer/single-consumer ring of PIPELINE_DEPTH slots.
+Usage:
+	pipeline.start(&source, config);
+	while((pkg = pipeline.next()) != NULL)
+		seg->setBuffer((u1*)pkg->m_buf, pkg->m_length, pkg->m_tag);
+*/
+class SegmentPipeline {
+public:
+	SegmentPipeline();
+	~SegmentPipeline();
+	/**
+	 *  Start the producer on source, kept by the caller till the end.
+	 *  @param config for the separators joint with numbers and ascii, can be NULL.
+	 *  @param encoding Transcoder::ENC_*, of the stream.
+	 *  @return 0, ok; -1, can not start the thread
+	 */
+	int start(PipelineSource* source, const Segmenter_ConfigObj* config,
+		int encoding = Transcoder::ENC_UTF8);
+	/**
+	 *  Wait for the next package, NUL terminated at m_length. It is the caller's till the next call.
+	 *  @return NULL, the stream is done.
+	 */
+	SegmentPkg* next();
+	/**
+	 *  @return byte offset of the package of the last next() in the UTF-8 stream.
+	 */
+	u8 offset() const { return m_offset; }
+	/**
+	 *  Stop the producer and wait for it, the packages not taken are dropped.
+	 */
+	void stop();
+public:
+	const static u4 PIPELINE_DEPTH = 4;
+	const static u4 READ_SIZE = 16*1024;
+protected:
+	static void* producerMain(void* arg);
+	void produce();
+	/**
+	 *  Fill pkg from the carried bytes and the stream.
+	 *  @return 0, the stream is done.
+	 */
+	int fill(SegmentPkg* pkg);
+	/**
+	 *  @return length of pkg to segment, the rest goes to the next package.
+	 */
+	u4 cut(SegmentPkg* pkg, u4 from);
+protected:
+	struct Slot {
+		SegmentPkg pkg;
+		u8 offset;
+	};
+	Slot m_slots[PIPELINE_DEPTH];
+	u4 m_head;		//next slot to take, the consumer's
+	u4 m_tail;		//next slot to fill, the producer's
+	u4 m_count;		//slots filled and not taken, protected by m_lock
+	u1 m_done;		//no more slots, protected by m_lock
+	u1 m_stop;
+	u1 m_taken;		//the consumer holds the slot before m_head
+	pthread_mutex_t m_lock;
+	pthread_cond_t m_cond;
+	pthread_t m_tid;
+	u1 m_running;
+
+	PipelineSource* m_source;
+	const Segmenter_ConfigObj* m_config;
+	Transcoder m_transcoder;
+	u1 m_eof;
+	std::vector<u1> m_carry;	//bytes read, not in a package yet
+	u4 m_carry_pos;
+	u8 m_produced;	//bytes put in packages
+	u8 m_offset;
+};
+
+} /* End of namespace css */
+#endif
@@ -28,169 +28,11 @@
 //#include <malloc.h>
 #include <stdexcept>
 #include "Segmenter.h"
+#include "Utf8_16.h"
 #include "csr_assert.h"
 
 namespace css {
 
-void ChineseCharTaggerImpl::init() {
-	/**
-	table format. 3part.
-	1 ASCII < 256
-	2 CJK u'\u4e00' < x < u'\u9fff'
-	3 Symbols 0xFF?? and iCode >= 0x3000)&&(iCode <= 0x303F
-	2 -> CJK part. 81 entry [9f-4e], each entry is 256 size. so the offset is [(high-byte - 4E) * 256 + low-byte]
-	total size is 256*(9f-4e)
-	*/
-	u1 ansipage[]= {
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			's', 'w', 'w', 's', 's', 's', 's', 'w',
-			's', 's', 's', 's', 'w', 's', 'w', 's',
-			'm', 'm', 'm', 'm', 'm', 'm', 'm', 'm',
-			'm', 'm', 'w', 'w', 's', 's', 's', 'w',
-			's', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 's', 's', 's', 's', 's',
-			's', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 's', 's', 's', 's', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', '\0',
-	};
-	//0xFF??
-	u1 sym1[]= {
-			'\0', 'w', 'w', 's', 's', 's', 's', 'w',
-			's', 's', 's', 's', 'w', 's', 's', 's',
-			'm', 'm', 'm', 'm', 'm', 'm', 'm', 'm',
-			'm', 'm', 'w', 's', 's', 's', 's', 'w',
-			's', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 's', 's', 's', 's', 's', 's',
-			'w', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 'e', 'e', 'e', 'e', 'e', 'e',
-			'e', 'e', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', 's', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-	};
-	// 0x30??
-	u1 sym2[]= {
-			's', 's', 'w', 'w', 's', 's', 's', 'm',
-			's', 's', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', 's', 's',
-			's', 's', 's', 's', 's', 's', 's', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-			'\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0',
-	};
-	//unicode Chinese number
-	u2 chs_number[] ={
-		0x4e00, 0x4e03, 0x4e09, 0x4e2a, 0x4e07, 0x9646, 0x4e5d, 0x767e, 0x8086, 0x4e8c,
-			0x4e94, 0x4ebf, 0x56db, 0x4edf, 0x96f6, 0x58f9, 0x62fe, 0x4f0d, 0x8d30, 0x5341,
-			0x5343, 0x5146, 0x634c, 0x516b, 0x516d, 0x4f70, 0x7396, 0x53c1, 0x67d2
-	};
-	memset(index_map,0,sizeof(index_map));
-	memcpy(ansi_map,ansipage,sizeof(ansipage));
-	index_map[0] = ansi_map;
-	u1* sym = new u1[256];
-	memcpy(sym,sym2,sizeof(sym2)); //0x30
-	index_map[0x30] = sym;
-	sym = new u1[256];
-	memcpy(sym,sym1,sizeof(sym1)); //0xff
-	index_map[0xFF] = sym;
-	//make cjk-map
-	for(int i=0; i< sizeof(chs_number)/sizeof(u2); i++){
-		u1 idx = chs_number[i]>>8;
-		u1* ptr = index_map[idx];
-		if(!ptr) {
-			ptr = new u1[256];
-			memset(ptr,0,256);
-			index_map[idx] = ptr;
-		}
-		ptr[(u1)chs_number[i]] = 'n'; //change tag from m -> n used by pure Chinese number
-	}
-	//unicode Chinese Symb 
-	//0x2018-0x201f && 0x2025-0x2027 && 0x2032-0x2037, //Not in Chinese Char range, used as sep. Generation Sep.
-	//# NOTE 0x22xx, 0x23xx is number symbol,
-	{
-		u1* ptr = new u1[256];
-		memset(ptr,'s',256);
-		index_map[0x22] = ptr;
-		index_map[0x23] = ptr;
-
-		ptr = new u1[256];
-		memset(ptr,0,256);
-		for(u2 i = 0x2018; i<= 0x201f; i++)
-			ptr[(u1)i] = 'w';
-		for(u2 i = 0x2025; i<= 0x2027; i++)
-			ptr[(u1)i] = 'w';
-		for(u2 i = 0x2032; i<= 0x2037; i++)
-			ptr[(u1)i] = 'w';
-		index_map[0x20] = ptr;
-	}
-}
 /**
 if fact we use low-byte only, high byte is reserved.
 */
@@ -209,27 +51,7 @@ u2 ChineseCharTaggerImpl::tagUnicode(u2 iCode, u1 length){
 		0x80, /* 3 char 1000 0000 */
 		0xC9 /* use length, 1100 0000 */
 	};
-	u1 c_type = 0;
-	u1 idx = iCode>>8;
-	if(index_map[idx]) {
-		c_type = index_map[idx][(u1)iCode];
-	}
-
-	if(c_type)
-		goto DONE;
-
-	if ((iCode >= 0x4E00)&&(iCode <= 0x9FA5)) //Chinese Char
-		c_type = 'c';
-	else
-		if((iCode >= 0x3000)&&(iCode <= 0x303F)) //Chinese Symbols and Punctuation
-			c_type =  's';
-		else	//Unknown char.
-			c_type = 'u';
-	if(c_type)
-		goto DONE;
-
-	return 0;
-DONE:
+	u1 c_type = tagClass(iCode);
 	return flags[length-1]|(c_type - 'a' + 1);
 }
 
@@ -415,6 +237,37 @@ int SegmentPkg::feedData(const char* buf,int length )
 	return -1;
 }
 
+u4 SegmentPkg::separatorCut(const u1* buf, u4 length, u4 pos, const Segmenter_ConfigObj* config)
+{
+	if(!pos || pos >= length)
+		return 0;
+	u2 len = 0;
+	int iCode = csr::csrUTF8Decode(&buf[pos], len);
+	if(iCode <= 0 || pos + len > length)
+		return 0;
+	if(config) {
+		if(config->isJoint(iCode))
+			return 0;
+		u4 prev = pos - 1;
+		while(prev > 0 && (buf[prev] & 0xC0) == 0x80 && pos - prev < 4)
+			prev--;
+		if(config->isJoint(csr::csrUTF8Decode(&buf[prev])))
+			return 0;
+	}
+	return pos + len;
+}
+
+void SegmentPkg::clear()
+{
+	//tagData leaves the tag of a wrong char as it was.
+	if(m_tag)
+		memset(m_tag, 0, m_size);
+	m_length = 0;
+	m_used = 0;
+	m_remains_bytes = 0;
+	m_wTagList.clear();
+}
+
 void SegmentPkg::setSize(int length)
 {
 	if(m_buf && m_size > length)
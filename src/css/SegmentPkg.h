@@ -24,42 +24,42 @@
 #ifndef css_SegmentPkg_h
 #define css_SegmentPkg_h
 #include <vector>
-#define HAVE_ATEXIT
-#include "Singleton.h"
 #include "csr_typedefs.h"
 
 namespace css {
 
+class Segmenter_ConfigObj;
+
+#include "char_tag_table.h"
+
 /*
 - find char-class
 - tolower case(optional, used in search.).
+the tables are generated, script/char_table_build.py and script/build_tolower_table.py; nothing to init.
 */
 class ChineseCharTaggerImpl
 {
 public:
-	ChineseCharTaggerImpl(){
-		init();
-	}
-
-	~ChineseCharTaggerImpl(){	
-		for(int i=1; i<256; i++) {
-			if(i == 0x23)
-				continue;
-			if(index_map[i])
-				delete[] index_map[i];
-		}
-	};
 	u2 tagUnicode(u2 iCode, u1 length);
-protected:
-	void init();
-	//We reduced the map. only number-char page is exist
-	//char cjk_map[20736]; // 256*(9f-4e) = 21k
-	u1* index_map[256];
-	u1 ansi_map[256];
-	//char sym_map[512]; // 0x3000 - 0x303F && 0xFF??
+	/**
+	 *  @return the class letter of the char, the low bits of tagUnicode.
+	 */
+	inline u1 tagClass(u2 iCode) {
+		return tag_pages[tag_page_index[iCode>>8]][iCode & 0xFF];
+	}
 };
 
-typedef CSR_Singleton<ChineseCharTaggerImpl> ChineseCharTagger;
+/*
+No state, the one instance is for the callers holding a tagger pointer.
+*/
+class ChineseCharTagger
+{
+public:
+	static ChineseCharTaggerImpl* Get() {
+		static ChineseCharTaggerImpl tagger;
+		return &tagger;
+	}
+};
 
 #include "tolowercase.h"
 
@@ -68,19 +68,13 @@ typedef CSR_Singleton<ChineseCharTaggerImpl> ChineseCharTagger;
 class ToLowerImpl
 {
 public:
-	ToLowerImpl(){};
 	inline u2 toLower(u2 k){
-		u1 idx = k>>8;
-		u2 iCode = k;
-		if(table_index[idx])
-			iCode = table_index[idx][k&0xFF];
+		u2 iCode = lower_pages[lower_page_index[k>>8]][k&0xFF];
 		if(iCode)
 			return iCode;
 		return k;
 	}
 };
-	
-typedef CSR_Singleton<ToLowerImpl> ToLower;
 
 class SegmentPkg {
 
@@ -110,6 +104,10 @@ public:
 	int feedData(const char* buf,int length);
 	int tagData(const char* buf,int length);
 	void setSize(int length);
+	/**
+	 *  Empty the pkg to be fed again, the buffers are kept.
+	 */
+	void clear();
 public:
 	/**
 	* read UTF-8 input can tagger the char-pos in tag array. tag length must equal or larger than buf. 
@@ -118,8 +116,16 @@ public:
 	* @return, the data remains untagged. must less than 3.
 	*/
 	int tagData(const char* buf, u1* tag, int length = 0, int offset = 0);
+	/**
+	 *  Check the separator at buf[pos], of m_wTagList, as a place to cut the text.
+	 *  MMSEG decisions never cross a separator, unless a number and ascii run goes through it:
+	 *  it or the char before is joint by the config.
+	 *  @param config can be NULL.
+	 *  @return the offset after the separator, 0 if the text can not be cut there.
+	 */
+	static u4 separatorCut(const u1* buf, u4 length, u4 pos, const Segmenter_ConfigObj* config);
 
-protected:
+public:
 	const static int DEFAULT_PACKAGE_LENGTH = 65400;
 };
 
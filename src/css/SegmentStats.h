@@ -0,0 +1,134 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_SegmentStats_h
+#define css_SegmentStats_h
+
+#include <string.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+#include "csr_typedefs.h"
+#include "csr_mutex.h"
+
+/*
+set MMSEG_STATS to 0 to compile the counters out, the snapshot is all zero then.
+*/
+#ifndef MMSEG_STATS
+#define MMSEG_STATS		1
+#endif
+//the stage time is measured on 1 of each MMSEG_STATS_SAMPLE chunks, and scaled.
+#ifndef MMSEG_STATS_SAMPLE
+#define MMSEG_STATS_SAMPLE	16
+#endif
+
+namespace css {
+
+/*
+Work done by segmenters, a plain snapshot.
+*/
+class SegmentStats {
+public:
+	u8 bytes;				//bytes consumed by popToken
+	u8 chars;				//chars decoded
+	u8 tokens;				//tokens emitted
+	u8 chunks;				//MMThunk::Tokenize calls, one per run of CJK chars
+	u8 positions;			//MMSEG decisions made
+	u8 candidates;			//chunks enumerated, candidates / positions is the average per position
+	u8 candidates_max;		//most chunks enumerated at one position
+	u8 rules[4];			//decisions made by rule 1 (maximum matching) ... rule 4 (largest freedom)
+	u8 find_hits;			//findHits calls on unigram and keyword dictionaries
+	u8 hits;				//items returned by them
+	u8 synonym_lookups;
+	u8 synonym_hits;
+	u8 thesaurus_lookups;
+	u8 thesaurus_hits;
+	u8 lookup_ns;			//time of chunk building, dictionary lookup included. sampled
+	u8 tokenize_ns;			//time of MMThunk::Tokenize. sampled
+public:
+	SegmentStats() { reset(); }
+	void reset() { memset(this, 0, sizeof(SegmentStats)); }
+	void merge(const SegmentStats& o) {
+		bytes += o.bytes;
+		chars += o.chars;
+		tokens += o.tokens;
+		chunks += o.chunks;
+		positions += o.positions;
+		candidates += o.candidates;
+		if(o.candidates_max > candidates_max)
+			candidates_max = o.candidates_max;
+		for(int i = 0; i < 4; i++)
+			rules[i] += o.rules[i];
+		find_hits += o.find_hits;
+		hits += o.hits;
+		synonym_lookups += o.synonym_lookups;
+		synonym_hits += o.synonym_hits;
+		thesaurus_lookups += o.thesaurus_lookups;
+		thesaurus_hits += o.thesaurus_hits;
+		lookup_ns += o.lookup_ns;
+		tokenize_ns += o.tokenize_ns;
+	}
+	static u8 now_ns() {
+#ifdef WIN32
+		LARGE_INTEGER freq, now;
+		QueryPerformanceFrequency(&freq);
+		QueryPerformanceCounter(&now);
+		return (u8)(now.QuadPart * 1000000000.0 / freq.QuadPart);
+#else
+		struct timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (u8)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+	}
+};
+
+/*
+The stats of a SegmenterManager. Segmenters count locally, and add their counters
+here at setBuffer (the previous document) or Segmenter::flushStats.
+*/
+class SegmentStatsSink {
+public:
+	void add(const SegmentStats& stats) {
+		m_lock.lock();
+		m_total.merge(stats);
+		m_lock.unlock();
+	}
+	void snapshot(SegmentStats* stats) {
+		m_lock.lock();
+		*stats = m_total;
+		m_lock.unlock();
+	}
+	void reset() {
+		m_lock.lock();
+		m_total.reset();
+		m_lock.unlock();
+	}
+protected:
+	CsrMutex m_lock;
+	SegmentStats m_total;
+};
+
+} /* End of namespace css */
+#endif
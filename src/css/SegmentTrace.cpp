@@ -0,0 +1,181 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "SegmentTrace.h"
+
+#ifdef WIN32
+#define MMSEG_THREAD_LOCAL	__declspec(thread)
+#else
+#include <pthread.h>
+#define MMSEG_THREAD_LOCAL	__thread
+#endif
+
+namespace css {
+
+static volatile u4 g_trace_sampling = 0;
+static MMSEG_THREAD_LOCAL TraceRing* t_trace_ring = NULL;
+//all rings ever created, never freed: dump may read a ring at any time.
+static std::vector<TraceRing*>* g_trace_rings = NULL;
+//rings of exited threads, taken by the next new thread.
+static std::vector<TraceRing*>* g_trace_idle = NULL;
+static CsrMutex g_trace_lock;
+
+#ifndef WIN32
+static pthread_once_t g_trace_once = PTHREAD_ONCE_INIT;
+static pthread_key_t g_trace_key;
+
+static void ring_exit(void* ring)
+{
+	g_trace_lock.lock();
+	g_trace_idle->push_back((TraceRing*)ring);
+	g_trace_lock.unlock();
+}
+
+static void ring_key_create()
+{
+	pthread_key_create(&g_trace_key, ring_exit);
+}
+#endif
+
+//@return the ring of a thread without one, an idle ring if any.
+static TraceRing* ring_take()
+{
+	g_trace_lock.lock();
+	if(!g_trace_rings) {
+		g_trace_rings = new std::vector<TraceRing*>();
+		g_trace_idle = new std::vector<TraceRing*>();
+	}
+	TraceRing* ring = NULL;
+	if(!g_trace_idle->empty()) {
+		ring = g_trace_idle->back();
+		g_trace_idle->pop_back();
+		//seq goes on, the older records stay readable until overwritten.
+		ring->m_docs = 0;
+	}else{
+		ring = new TraceRing((u4)g_trace_rings->size());
+		g_trace_rings->push_back(ring);
+	}
+	g_trace_lock.unlock();
+#ifndef WIN32
+	pthread_once(&g_trace_once, ring_key_create);
+	pthread_setspecific(g_trace_key, ring);
+#endif
+	return ring;
+}
+
+TraceRing::TraceRing(u4 index)
+	:m_index(index), m_docs(0), m_head(0)
+{
+	m_records = new TraceRecord[CAPACITY];
+	memset(m_records, 0, sizeof(TraceRecord)*CAPACITY);
+}
+
+TraceRing::~TraceRing()
+{
+	delete[] m_records;
+}
+
+void SegmentTrace::setSampling(u4 one_in)
+{
+	g_trace_sampling = one_in;
+}
+
+u4 SegmentTrace::getSampling()
+{
+	return g_trace_sampling;
+}
+
+TraceRing* SegmentTrace::begin(u4 length)
+{
+	u4 one_in = g_trace_sampling;
+	if(!one_in)
+		return NULL;
+	TraceRing* ring = t_trace_ring;
+	if(!ring) {
+		ring = ring_take();
+		t_trace_ring = ring;
+	}
+	if((ring->m_docs++ % one_in) != 0)
+		return NULL;
+	TraceRecord* rec = ring->next();
+	rec->type = TraceRecord::DOCUMENT;
+	rec->count = 0;
+	rec->pos = 0;
+	rec->value = length;
+	ring->commit(rec);
+	return ring;
+}
+
+int SegmentTrace::dump(const char* filename)
+{
+	FILE* fp = fopen(filename, "wb");
+	if(!fp)
+		return -1;
+	g_trace_lock.lock();
+	std::vector<TraceRing*> rings;
+	if(g_trace_rings)
+		rings = *g_trace_rings;
+	g_trace_lock.unlock();
+
+	_csr_trace_fileheader head;
+	memcpy(head.mg, trace_head_mgc, 4);
+	head.version = 1;
+	head.record_size = sizeof(TraceRecord);
+	head.ring_count = (u4)rings.size();
+	int bad = fwrite(&head, sizeof(head), 1, fp) != 1;
+	std::vector<TraceRecord> records;
+	for(size_t i = 0; i < rings.size() && !bad; i++) {
+		TraceRing* ring = rings[i];
+		_csr_trace_ringheader rh;
+		rh.index = ring->m_index;
+		rh.head = ring->m_head;
+		CSR_MEMORY_BARRIER();
+		u4 count = rh.head < TraceRing::CAPACITY ? rh.head : TraceRing::CAPACITY;
+		//oldest first. The writer goes on meanwhile: a record is kept only if its seq
+		//is the expected one both before and after the copy.
+		records.resize(count);
+		rh.count = 0;
+		for(u4 j = 0; j < count; j++) {
+			u4 seq = rh.head - count + j;
+			volatile TraceRecord* rec = &ring->m_records[seq & (TraceRing::CAPACITY - 1)];
+			if(rec->seq != seq)
+				continue;
+			CSR_MEMORY_BARRIER();
+			memcpy(&records[rh.count], (const void*)rec, sizeof(TraceRecord));
+			CSR_MEMORY_BARRIER();
+			if(rec->seq != seq)
+				continue;
+			rh.count++;
+		}
+		bad |= fwrite(&rh, sizeof(rh), 1, fp) != 1;
+		if(rh.count && !bad)
+			bad |= fwrite(&records[0], sizeof(TraceRecord), rh.count, fp) != rh.count;
+	}
+	bad |= fclose(fp) != 0;
+	return bad ? -1 : 0;
+}
+
+} /* End of namespace css */
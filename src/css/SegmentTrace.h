@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_SegmentTrace_h
+#define css_SegmentTrace_h
+
+#include "csr_typedefs.h"
+#include "csr_mutex.h"
+
+namespace css {
+
+/*
+A binary trace of MMSEG decisions, replaces the CHUNK_DEBUG printf.
+
+Each thread writes its own ring of fixed size records, no lock on the write path.
+A record is taken by next() and published by commit(), which stamps its seq; dump()
+keeps only the records whose seq is the same before and after copying them.
+A ring is taken over by a new thread once its thread exits ([*nix only]).
+Tracing is off by default; SegmentTrace::setSampling(n) switches it on at runtime,
+for 1 of each n documents (counted per thread). The unsampled documents pay one
+pointer check per MMSEG decision.
+
+dump() writes all rings into a file, read by mmseg-trace.
+*/
+struct TraceRecord {
+	enum {
+		DOCUMENT = 1,	//value: document length
+		CHUNK = 2,		//value: byte offset of the chunk in the document, pos: chunk length
+		CANDIDATE = 3,	//pos: position in chunk, count/lens/freqs: the chunk, value: total length
+		DECISION = 4	//pos: position in chunk, value: token length chosen, rule: 1-4
+	};
+	u1 type;
+	u1 count;
+	u2 pos;
+	u4 value;
+	u2 lens[3];
+	u2 rule;
+	u2 freqs[3];
+	u2 reserve;
+	float avl;		//rule 2, average length
+	float var;		//rule 3, variance of lengths
+	float freedom;	//rule 4, sum of log(freq)
+	u4 seq;			//sequence of the record in its ring, SEQ_BUSY while written
+	const static u4 SEQ_BUSY = 0xFFFFFFFF;
+};
+
+//the dump file: header, then ring_count * (ring header, count * TraceRecord)
+const char trace_head_mgc[] = "MMTR";
+
+typedef struct _csr_trace_fileheader_tag{
+	char mg[4];
+	short version;
+	short record_size;
+	u4	ring_count;
+}_csr_trace_fileheader;
+
+typedef struct _csr_trace_ringheader_tag{
+	u4	index;
+	u4	head;
+	u4	count;	//records follow, oldest first
+}_csr_trace_ringheader;
+
+class TraceRing {
+public:
+	TraceRing(u4 index);
+	~TraceRing();
+	//the record to fill, then commit it.
+	inline TraceRecord* next() {
+		TraceRecord* rec = &m_records[m_head & (CAPACITY - 1)];
+		rec->seq = TraceRecord::SEQ_BUSY;
+		CSR_MEMORY_BARRIER();
+		return rec;
+	}
+	inline void commit(TraceRecord* rec) {
+		CSR_MEMORY_BARRIER();
+		rec->seq = m_head;
+		m_head = m_head + 1;
+	}
+public:
+	const static u4 CAPACITY = 8192;	//records, power of 2
+	u4 m_index;			//the ring, in order of creation
+	u4 m_docs;			//documents seen while sampling
+	volatile u4 m_head;	//records written
+	TraceRecord* m_records;
+};
+
+class SegmentTrace {
+public:
+	/**
+	 *  @param one_in trace 1 of each one_in documents, 0 to switch off.
+	 */
+	static void setSampling(u4 one_in);
+	static u4 getSampling();
+	/**
+	 *  Called at each new document.
+	 *  @return the ring of current thread if the document is sampled, NULL if not.
+	 */
+	static TraceRing* begin(u4 length);
+	/**
+	 *  Write the rings of all threads to filename. The records being written while
+	 *  dumping are left out.
+	 *  @return 0, ok; -1, can not write
+	 */
+	static int dump(const char* filename);
+};
+
+} /* End of namespace css */
+#endif
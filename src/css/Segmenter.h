@@ -25,17 +25,21 @@
 #define css_Segmenter_h
 
 #include <vector>
+#include <string.h>
 #ifdef WIN32
 #include <hash_map>
 #else
 #include <ext/hash_map>
 #endif
 #include "SegmentPkg.h"
+#include "CharNormalizer.h"
+#include "CharDecoder.h"
 #include "UnigramDict.h"
 #include "SynonymsDict.h"
 #include "csr_typedefs.h"
 #include "freelist.h"
 #include "mmthunk.h"
+#include "SegmentStats.h"
 
 #include <algorithm>
 #include <fstream>
@@ -113,44 +117,135 @@ public:
 	u1 seperate_number_ascii;
 	//TODO: compress_space is still unsupported, for spaces can be handled in stopword list.
 	u1 compress_space;
-	u1 number_and_ascii_joint[512];
+	u1 number_and_ascii_joint[512];	//UTF-8
+	u1 joint_map[0x10000 / 8];	//chars of number_and_ascii_joint, a bit each, by compileJoint
 	u1 omni_segmentation;
+	u1 normalize;	//CharNormalizer::NORMALIZE_*, applied to dictionary lookups.
 	Segmenter_ConfigObj():
 		merge_number_and_ascii(0),
 		seperate_number_ascii(0),
 		compress_space(0),
-		omni_segmentation(0)
+		omni_segmentation(0),
+		normalize(0)
 	{
 		number_and_ascii_joint[0] = 0;
+		memset(joint_map, 0, sizeof(joint_map));
+	}
+	/**
+	 *  Build joint_map, once number_and_ascii_joint is set.
+	 */
+	void compileJoint();
+	inline int isJoint(int iCode) const {
+		return iCode > 0 && iCode < 0x10000 && (joint_map[iCode >> 3] & (1 << (iCode & 7)));
 	}
 };
 
+/*
+A token with its place in the source text, filled by Segmenter::nextToken.
+*/
+class TokenInfo {
+public:
+	u4 offset;			//byte offset in the buffer
+	u4 length;			//bytes in the buffer
+	u4 char_offset;		//UTF-16 code units before the token
+	u4 char_length;		//UTF-16 code units of the token
+	const u1* text;		//the token text, the replacement if a synonym matched
+	u2 text_length;
+	u1 replaced;		//text is the synonym, not in the buffer
+};
+
 class Segmenter {
 
  public:
 
 
     /** 
+     *  @param tags per byte tags of buf by SegmentPkg::tagData, the chars are not tagged again.
      *  @return 0
      */
-	void setBuffer(u1* buf, u4 length);
+	void setBuffer(u1* buf, u4 length, const u1* tags = NULL);
 	const u1* popOmniToken(u2& aLen);
+	/**
+	 *  Bulk version of popOmniToken, fetch all omni tokens up to current position in offset order.
+	 *  item's offset is relative to the buffer begin.
+	 *  @return the count of items filled.
+	 */
+	u4 popOmniTokens(OmniItem* items, u4 max_items);
 	const u1* peekToken(u2& aLen, u2& aSymLen, u2 n = 0);
 	void popToken(u2 len, u2 n = 0);
 	void segNgram(int n) { m_ngram = n; }
+	/**
+	 *  @return the byte offset of the next token in the buffer.
+	 */
 	int getOffset();
+	/**
+	 *  @return the UTF-16 code units before the next token.
+	 */
+	u4 getCharOffset() { return m_char_offset; }
+	/**
+	 *  Peek and pop the next token, with its offsets.
+	 *  @return 0, no more token.
+	 */
+	u1 nextToken(TokenInfo& info);
 	u1  isSentenceEnd();
+	/**
+	 *  Segment the whole buffer, append (start, end) byte offsets of each token to offsets.
+	 *  buf should be NUL terminated, as setBuffer.
+	 *  @return the count of tokens.
+	 */
+	u4 segmentOffsets(u1* buf, u4 length, std::vector<u4>& offsets);
+	/**
+	 *  Segment a short text, e.g. a search query, into offsets as (start, end) pairs, the same
+	 *  tokens as segmentOffsets. Up to QUERY_MAX_LENGTH bytes, it skips the per document work:
+	 *  the counters are flushed by the next setBuffer or flushStats, and it's never traced.
+	 *  buf should be NUL terminated, as setBuffer.
+	 *  @return the count of pairs, at most max_tokens.
+	 */
+	u4 segmentQuery(u1* buf, u4 length, u4* offsets, u4 max_tokens);
+	/**
+	 *  Add the local counters to the manager's, done by setBuffer too.
+	 */
+	void flushStats();
+	/**
+	 *  Pick the peekToken kernel for the dictionaries and config set, done by SegmenterManager::getSegmenter.
+	 *  Call it again after changing them.
+	 */
+	void selectKernel();
 	int isKeyWord(u1* buf, u4 length);
 	int getWordWeight(u1* buf, u4 length);
 	
 	const char* thesaurus(const char* key, u2 key_len);
     Segmenter();
 	~Segmenter();
+public:
+	const static u4 QUERY_MAX_LENGTH = 256;
 
 protected:
+	/**
+	 *  Start segmenting buf, the work of setBuffer and segmentQuery.
+	 *  @param bFlush flush the counters of the last text first
+	 *  @param bTrace let SegmentTrace decide whether the text is traced
+	 */
+	void resetBuffer(u1* buf, u4 length, const u1* tags, u1 bFlush, u1 bTrace);
 	const u1* peekKwToken(u2& aLen, u2& aSymLen);
 	void  popKwToken(u2 len);
+	u1 nextOmniWindow();
+	//features a kernel checks for, the others cost nothing.
+	enum {
+		KERNEL_KW = 1,			//m_kwdict
+		KERNEL_SYNONYM = 2,		//m_symdict loaded
+		KERNEL_NORMALIZE = 4,	//m_config->normalize
+		KERNEL_NUMBER_RULES = 8,	//merge, seperate or joint of number and ascii
+		KERNEL_ALL = 15
+	};
+	template <int FLAGS> const u1* peekKernel(u2& aLen, u2& aSymLen);
+	typedef const u1* (Segmenter::*PeekKernel)(u2& aLen, u2& aSymLen);
+	PeekKernel m_kernel;
 public:
+	/**
+	 *  Copy the NUL terminated UTF-8 src to det in lower case, as normalize_case.
+	 *  @return 0, ok; 1, det is too small
+	 */
 	static int toLowerCpy(const u1* src, u1* det, u2 det_size);
 protected:
 	int m_begin_id;
@@ -163,19 +258,27 @@ protected:
 	MMThunk m_thunk;
 	//static ToLowerImpl* m_lower;
 public:
+	SegmentStats m_stats;	//since last flushStats
+	SegmentStatsSink* m_stats_sink;	//of the manager, set by getSegmenter
 
     UnigramDict * m_unidict;
 	UnigramDict * m_kwdict;
 	UnigramDict * m_weightdict;
 	SynonymsDict * m_symdict;
 	ThesaurusDict * m_thesaurus;
+	CharNormalizer * m_normalizer;
 	
 	Segmenter_ConfigObj* m_config;
 	//mmseg used.
 	u1* m_buffer_begin;
 	u1* m_buffer_ptr;
 	u1* m_buffer_chunk_begin;
+	u1* m_buffer_chunk_end;	//end of the chars looked up in the window
 	u1* m_buffer_end;
+	const u1* m_buffer_tags;	//of SegmentPkg, NULL if not tagged
+	u4 m_char_offset;	//UTF-16 code units before m_buffer_ptr
+	NormalizedText m_norm;	//of the current window, if m_config->normalize
+	CharDecoder m_decoder;
 };
 
 } /* End of namespace css */
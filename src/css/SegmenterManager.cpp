@@ -29,11 +29,6 @@ extern "C"{
 namespace css {
 
 
-const char g_ngram_unigram_dict_name[] = "uni.lib";
-const char g_kword_unigram_dict_name[] = "kw.lib";
-const char g_wordweight_unigram_dict_name[] = "weight.lib";
-const char g_synonyms_dict_name[] = "synonyms.dat";
-const char g_thesaurus_dict_name[] = "thesaurus.lib";
 const char g_config_name[] = "mmseg.ini";
 /** 
  *  Return a newly created segmenter
@@ -48,30 +43,38 @@ Segmenter *SegmenterManager::getSegmenter( bool bFromPool)
 		else
 			seg = new Segmenter();
 		//init seg
-		seg->m_unidict = &m_uni;
-		seg->m_symdict = &m_sym;
-		if(m_kw.isLoad())
-			seg->m_kwdict = &m_kw;
-		if(m_weight.isLoad())
-			seg->m_weightdict =  &m_weight;
-		if(m_thesaurus.isLoad())
-			seg->m_thesaurus = &m_thesaurus;
+		seg->m_unidict = &m_dicts->m_uni;
+		seg->m_symdict = &m_dicts->m_sym;
+		if(m_dicts->m_kw.isLoad())
+			seg->m_kwdict = &m_dicts->m_kw;
+		if(m_dicts->m_weight.isLoad())
+			seg->m_weightdict =  &m_dicts->m_weight;
+		if(m_dicts->m_thesaurus.isLoad())
+			seg->m_thesaurus = &m_dicts->m_thesaurus;
+		seg->m_normalizer = &m_dicts->m_normalizer;
 		seg->m_config = &m_config;
+		seg->m_stats_sink = &m_stats;
+		seg->selectKernel();
 	}		
 	return seg;
 }
 
 void SegmenterManager::loadconfig(const char* confile)
+{
+	parseconfig(confile, &m_config);
+}
+
+int SegmenterManager::parseconfig(const char* confile, Segmenter_ConfigObj* config)
 {
 	if(confile == NULL)
-		return;
+		return -1;
 	dictionary	*	ini;
 	char		*	s;
 	int sl = 0;
 	//m_config
 	ini = iniparser_load(confile);
 	if (ini==NULL) {
-		return; // not exist or not a valid ini file
+		return -1; // not exist or not a valid ini file
 	}
 	/*
 	u1 merge_number_and_ascii;
@@ -79,26 +82,36 @@ void SegmenterManager::loadconfig(const char* confile)
 	u1 compress_space;
 	u1 number_and_ascii_joint[512];
 	*/
-	m_config.merge_number_and_ascii = 
+	config->merge_number_and_ascii = 
 		iniparser_getboolean(ini, "mmseg:merge_number_and_ascii", 0);
-	m_config.seperate_number_ascii = 
+	config->seperate_number_ascii = 
 		iniparser_getboolean(ini, "mmseg:seperate_number_ascii", 0);
-	m_config.compress_space = 
+	config->compress_space = 
 		iniparser_getboolean(ini, "mmseg:compress_space", 0);
 	s = 
 		iniparser_getstring(ini, "mmseg:number_and_ascii_joint", NULL);
 	if(s){
 		sl = strlen(s);
 		if(sl>511){
-			memcpy(m_config.number_and_ascii_joint,s,sl);
-			m_config.number_and_ascii_joint[511] = 0;
+			memcpy(config->number_and_ascii_joint,s,511);
+			config->number_and_ascii_joint[511] = 0;
 		}else{
-			memcpy(m_config.number_and_ascii_joint,s,sl);
-			m_config.number_and_ascii_joint[sl] = 0;
+			memcpy(config->number_and_ascii_joint,s,sl);
+			config->number_and_ascii_joint[sl] = 0;
 		}
 	}
-	m_config.omni_segmentation = 
+	config->compileJoint();
+	config->omni_segmentation = 
 		iniparser_getint(ini, "mmseg:omni_segmentation", 2); //output this only when term weight over 2
+	config->normalize = 0;
+	if(iniparser_getboolean(ini, "mmseg:normalize_case", 0))
+		config->normalize |= CharNormalizer::NORMALIZE_CASE;
+	if(iniparser_getboolean(ini, "mmseg:normalize_width", 0))
+		config->normalize |= CharNormalizer::NORMALIZE_WIDTH;
+	if(iniparser_getboolean(ini, "mmseg:normalize_t2s", 0))
+		config->normalize |= CharNormalizer::NORMALIZE_T2S;
+	iniparser_freedict(ini);
+	return 0;
 }
 
 int SegmenterManager::init(const char* path, u1 method, bool force_load)
@@ -109,6 +122,21 @@ int SegmenterManager::init(const char* path, u1 method, bool force_load)
 	if( m_inited  && !force_load)
 		return 0; //only can be init once.
 	
+	int nRet = 0;
+	if(DictBundle::isBundle(path)) {
+		m_method = method;
+		seg_freelist_.set_size(64);
+		SharedDicts* dicts = DictRegistry::acquire(path, &nRet);
+		if(!dicts)
+			return nRet;
+		DictRegistry::release(m_dicts);
+		m_dicts = dicts;
+		if(dicts->m_has_config)
+			m_config = dicts->m_config;
+		m_inited = 1;
+		return 0;
+	}
+
 	char buf[1024];
 	memset(buf,0,sizeof(buf));
 	if(!path)
@@ -129,52 +157,16 @@ int SegmenterManager::init(const char* path, u1 method, bool force_load)
 	}
 #endif
 	m_method = method;
-	int nRet = 0;
 
 	if(method == SEG_METHOD_NGRAM) {
 		seg_freelist_.set_size(64);
-		memcpy(&buf[nLen],g_ngram_unigram_dict_name,strlen(g_ngram_unigram_dict_name));
-		nRet = m_uni.load(buf);
-
-		if(nRet!=0){
-			printf("Unigram dictionary load Error(%d), %s\n", nRet, buf);
-			return nRet;
-		}
-		//no needs to care kwformat
-		memcpy(&buf[nLen],g_kword_unigram_dict_name,strlen(g_kword_unigram_dict_name));
-		buf[nLen+strlen(g_kword_unigram_dict_name)] = 0;
-		nRet = m_kw.load(buf);
-		if(nRet!=0 && nRet!=-1 ){
-			//m_kw not exist or format error.
-			printf("Keyword dictionary load Error\n");
-			return nRet;
-		}
-
-		//try to load weight dict
-		memcpy(&buf[nLen],g_wordweight_unigram_dict_name,strlen(g_wordweight_unigram_dict_name));
-		buf[nLen+strlen(g_wordweight_unigram_dict_name)] = 0;
-		nRet = m_weight.load(buf);
-		if(nRet!=0 && nRet!=-1 ){
-			//m_kw not exist or format error.
-			printf("Keyword dictionary load Error\n");
+		buf[nLen] = 0;
+		SharedDicts* dicts = DictRegistry::acquire(buf, &nRet);
+		if(!dicts)
 			return nRet;
-		}
-		
-		memcpy(&buf[nLen],g_synonyms_dict_name,strlen(g_synonyms_dict_name));
-		buf[nLen+strlen(g_synonyms_dict_name)] = 0;
-		//load g_synonyms_dict_name, we do not care the load in right or not
-		nRet = m_sym.load(buf);
-		if(nRet!=0 && nRet != -1){
-			printf("Synonyms dictionary format Error\n");
-		}
-
-		memcpy(&buf[nLen],g_thesaurus_dict_name,strlen(g_thesaurus_dict_name));
-		buf[nLen+strlen(g_thesaurus_dict_name)] = 0;
-		//load g_synonyms_dict_name, we do not care the load in right or not
-		nRet = m_thesaurus.load(buf);
-		if(nRet!=0 && nRet != -1){
-			printf("Thesaurus dictionary format Error\n");
-		}
+		//force_load, the same files get the same instance back.
+		DictRegistry::release(m_dicts);
+		m_dicts = dicts;
 
 		//read config
 		memcpy(&buf[nLen],g_config_name,strlen(g_config_name));
@@ -193,13 +185,14 @@ void SegmenterManager::clear()
     seg_freelist_.free();
 }
 SegmenterManager::SegmenterManager()
-		:m_inited(0)
+		:m_dicts(NULL), m_inited(0)
 {
 	m_method = SEG_METHOD_NGRAM;
 }
 SegmenterManager::~SegmenterManager()
 {
 	clear();
+	DictRegistry::release(m_dicts);
 }
 } /* End of namespace css */
 
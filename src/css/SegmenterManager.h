@@ -27,9 +27,7 @@
 #include <string>
 #include "freelist.h"
 
-#include "UnigramDict.h"
-#include "SynonymsDict.h"
-#include "ThesaurusDict.h"
+#include "DictRegistry.h"
 #include "Segmenter.h"
 
 namespace css {
@@ -48,7 +46,18 @@ class SegmenterManager {
 
     virtual int init(const char* path, u1 method = SEG_METHOD_NGRAM, bool force_load = false);
 	void loadconfig(const char* confile);
+	/**
+	 *  Parse the ini file into config, shared with the bundle builder.
+	 *  @return 0, ok; -1, not exist or not a valid ini file
+	 */
+	static int parseconfig(const char* confile, Segmenter_ConfigObj* config);
     void clear();
+	/**
+	 *  Snapshot of the counters of all segmenters from this manager.
+	 *  A segmenter adds its counters at the next setBuffer, or Segmenter::flushStats.
+	 */
+	void getStats(SegmentStats* stats) { m_stats.snapshot(stats); }
+	void resetStats() { m_stats.reset(); }
 
 	SegmenterManager();
 	virtual ~SegmenterManager();
@@ -57,12 +66,9 @@ public:
 	const static u1 SEG_METHOD_NGRAM = 0x1;
 protected:
 	CRFPP::FreeList<Segmenter> seg_freelist_;    
-	UnigramDict m_uni;
-	UnigramDict m_kw;
-	UnigramDict m_weight;
-	SynonymsDict m_sym;
-	ThesaurusDict m_thesaurus;
+	SharedDicts* m_dicts;	//from DictRegistry, shared with other managers of the same path.
 	Segmenter_ConfigObj m_config;
+	SegmentStatsSink m_stats;
 	u1 m_method;
 	u1 m_inited;
 	char m_msg[1024];
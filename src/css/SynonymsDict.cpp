@@ -46,9 +46,14 @@ int SynonymsDict::load(const char* filename)
 	m_file = csr_mmap_file(filename,1);
 	if(!m_file)
 		return -1; //can not load dict.
-	csr_offset_t tm_size = csr_mmap_size(m_file);
-	u1* ptr = (u1*)csr_mmap_map(m_file);
-	u1* ptr_end = ptr + tm_size;
+	return attach((u1*)csr_mmap_map(m_file), csr_mmap_size(m_file));
+}
+
+int SynonymsDict::attach(u1* ptr, csr_offset_t size)
+{
+	if(size < sizeof(_csr_synonymsdict_fileheader))
+		return -4; //file broken.
+	u1* ptr_end = ptr + size;
 	_csr_synonymsdict_fileheader* head_ = (_csr_synonymsdict_fileheader*)ptr;
 	if(strncmp(head_->mg,head_mgc,4) == 0) {
 		if(head_->version == 1) {
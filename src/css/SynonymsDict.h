@@ -63,6 +63,11 @@ class SynonymsDict {
 	 }
 
     virtual int load(const char* filename);
+    /** 
+     *  Use an image already in memory, which must outlive the dictionary.
+     *  @return 0, ok
+     */
+    int attach(u1* ptr, csr_offset_t size);
 
     virtual int import(const char* filename);
 
@@ -70,6 +75,7 @@ class SynonymsDict {
 
     virtual const char* exactMatch(const char* key, int len = 0);
 	virtual const char* maxMatch(const char* key, int &len);
+	int isLoad() const { return array_ != NULL; }
 
 protected:
 	_csr_mmap_t* m_file;
@@ -30,10 +30,14 @@ int ThesaurusDict::load(const char* filename)
 	m_file = csr_mmap_file(filename,1); //load all into memory
 	if(!m_file)
 		return -1; //can not load dict.
+	return attach((u1*)csr_mmap_map(m_file), csr_mmap_size(m_file));
+}
 
-	csr_offset_t tm_size = csr_mmap_size(m_file);
-	u1* ptr = (u1*)csr_mmap_map(m_file);
-	u1* ptr_end = ptr + tm_size;
+int ThesaurusDict::attach(u1* ptr, csr_offset_t size)
+{
+	if(size < sizeof(_csr_thesaurusdict_fileheader))
+		return -4; //file broken.
+	u1* ptr_end = ptr + size;
 
 	_csr_thesaurusdict_fileheader* head_ = (_csr_thesaurusdict_fileheader*)ptr;
 	if(strncmp(head_->mg,thdt_head_mgc,4) == 0) {
@@ -42,6 +42,11 @@ class ThesaurusDict {
  
  public:
     virtual int load(const char* filename);	
+    /** 
+     *  Use an image already in memory, which must outlive the dictionary.
+     *  @return 0, ok
+     */
+    int attach(u1* ptr, csr_offset_t size);
 	int import(const char* filename, const char* target_file = NULL);
 	const char* find(const char* key,u2 key_len , int *count = NULL); //the return string buffer might contains 0, end with \0\0
 	int isLoad()
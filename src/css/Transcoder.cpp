@@ -0,0 +1,430 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <string.h>
+#include "Transcoder.h"
+#include "gb18030_table.h"
+
+namespace css {
+
+#define REPLACEMENT_CHAR	0xFFFD
+#define GB4_SUPPLEMENT_BASE	189000	//linear index of 0x90308130, U+10000
+#define DETECT_SAMPLE	65536
+#define DETECT_HEAD		4096	//bytes a streamed text is detected by
+#define FEED_BLOCK		16384	//input bytes converted a step, the output buffer is 3 times
+
+static inline void put_utf8(u4 c, u1*& o)
+{
+	if(c < 0x80) {
+		*o++ = (u1)c;
+	}else if(c < 0x800) {
+		o[0] = (u1)(0xC0 | (c >> 6));
+		o[1] = (u1)(0x80 | (c & 0x3F));
+		o += 2;
+	}else if(c < 0x10000) {
+		o[0] = (u1)(0xE0 | (c >> 12));
+		o[1] = (u1)(0x80 | ((c >> 6) & 0x3F));
+		o[2] = (u1)(0x80 | (c & 0x3F));
+		o += 3;
+	}else{
+		o[0] = (u1)(0xF0 | (c >> 18));
+		o[1] = (u1)(0x80 | ((c >> 12) & 0x3F));
+		o[2] = (u1)(0x80 | ((c >> 6) & 0x3F));
+		o[3] = (u1)(0x80 | (c & 0x3F));
+		o += 4;
+	}
+}
+
+//copy the ASCII start at p, 8 bytes a time.
+static inline const u1* copy_ascii(const u1* p, const u1* end, u1*& o)
+{
+	while(p + 8 <= end) {
+		u8 w;
+		memcpy(&w, p, 8);
+		if(w & 0x8080808080808080ULL)
+			break;
+		memcpy(o, &w, 8);
+		o += 8;
+		p += 8;
+	}
+	while(p < end && *p < 0x80)
+		*o++ = *p++;
+	return p;
+}
+
+//code point of a four bytes GB18030 char, 0 if not mapped.
+static u4 gb4_code(u4 linear)
+{
+	if(linear >= GB4_SUPPLEMENT_BASE) {
+		u4 c = 0x10000 + linear - GB4_SUPPLEMENT_BASE;
+		return c <= 0x10FFFF ? c : 0;
+	}
+	u4 lo = 0, hi = sizeof(gb4_ranges) / sizeof(gb4_ranges[0]);
+	while(lo < hi) {
+		u4 mid = (lo + hi) / 2;
+		if(gb4_ranges[mid][0] <= linear)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if(!lo || linear > gb4_ranges[lo - 1][2])
+		return 0;
+	return gb4_ranges[lo - 1][1] + linear - gb4_ranges[lo - 1][0];
+}
+
+u4 Transcoder::convertGB(const u1* p, const u1* end, u1*& o, int final)
+{
+	const u1* begin = p;
+	int four_bytes = (m_encoding == ENC_GB18030);
+	while(p < end) {
+		u1 b1 = *p;
+		if(b1 < 0x80) {
+			p = copy_ascii(p, end, o);
+			continue;
+		}
+		u4 c = REPLACEMENT_CHAR;
+		u4 len = 1;
+		if(b1 >= 0x81 && b1 <= 0xFE) {
+			if(p + 1 >= end) {
+				if(!final)
+					break;
+			}else{
+				u1 b2 = p[1];
+				if(b2 >= 0x40 && b2 <= 0xFE && b2 != 0x7F) {
+					u2 v = gb2_table[(b1 - 0x81) * 190 + b2 - 0x40 - (b2 > 0x7F)];
+					if(v) {
+						c = v;
+						len = 2;
+					}else if(b2 >= 0x80)
+						len = 2;	//an ASCII trail is kept as is
+				}else if(four_bytes && b2 >= 0x30 && b2 <= 0x39) {
+					if(p + 3 >= end) {
+						if(!final)
+							break;
+					}else if(p[2] >= 0x81 && p[2] <= 0xFE && p[3] >= 0x30 && p[3] <= 0x39) {
+						u4 linear = (((b1 - 0x81) * 10 + b2 - 0x30) * 126 + p[2] - 0x81) * 10 + p[3] - 0x30;
+						u4 v = gb4_code(linear);
+						if(v)
+							c = v;
+						len = 4;
+					}
+				}
+			}
+		}
+		put_utf8(c, o);
+		p += len;
+	}
+	return (u4)(p - begin);
+}
+
+u4 Transcoder::convertUtf16(const u1* p, const u1* end, u1*& o, int final)
+{
+	const u1* begin = p;
+	int lo = (m_encoding == ENC_UTF16LE) ? 0 : 1;	//the low byte of a unit
+	int hi = 1 - lo;
+	while(p + 1 < end) {
+		//ASCII, 4 units a time.
+		while(p + 8 <= end && !(p[hi] | p[hi + 2] | p[hi + 4] | p[hi + 6])
+			&& !((p[lo] | p[lo + 2] | p[lo + 4] | p[lo + 6]) & 0x80)) {
+			o[0] = p[lo];
+			o[1] = p[lo + 2];
+			o[2] = p[lo + 4];
+			o[3] = p[lo + 6];
+			o += 4;
+			p += 8;
+		}
+		if(p + 1 >= end)
+			break;
+		u4 u = p[lo] | (p[hi] << 8);
+		u4 len = 2;
+		if(u >= 0xD800 && u <= 0xDBFF) {
+			if(p + 3 >= end) {
+				if(!final)
+					break;
+				u = REPLACEMENT_CHAR;
+			}else{
+				u4 u2 = p[2 + lo] | (p[2 + hi] << 8);
+				if(u2 >= 0xDC00 && u2 <= 0xDFFF) {
+					u = 0x10000 + ((u - 0xD800) << 10) + (u2 - 0xDC00);
+					len = 4;
+				}else
+					u = REPLACEMENT_CHAR;
+			}
+		}else if(u >= 0xDC00 && u <= 0xDFFF)
+			u = REPLACEMENT_CHAR;
+		put_utf8(u, o);
+		p += len;
+	}
+	if(final && p < end) {
+		//an odd byte at the end
+		put_utf8(REPLACEMENT_CHAR, o);
+		p = end;
+	}
+	return (u4)(p - begin);
+}
+
+u4 Transcoder::convert(const u1* p, const u1* end, u1*& o, int final)
+{
+	switch(m_encoding) {
+	case ENC_UTF16LE:
+	case ENC_UTF16BE:
+		return convertUtf16(p, end, o, final);
+	case ENC_GBK:
+	case ENC_GB18030:
+		return convertGB(p, end, o, final);
+	default:
+		memcpy(o, p, end - p);
+		o += end - p;
+		return (u4)(end - p);
+	}
+}
+
+u4 Transcoder::start(const u1* head, u4 length)
+{
+	if(m_encoding == ENC_AUTO)
+		m_encoding = detect(head, length);
+	m_started = 1;
+	if(length >= 2 && ((m_encoding == ENC_UTF16LE && head[0] == 0xFF && head[1] == 0xFE)
+		|| (m_encoding == ENC_UTF16BE && head[0] == 0xFE && head[1] == 0xFF)))
+		return 2;
+	return 0;
+}
+
+u4 Transcoder::feed(const u1* buf, u4 length, std::vector<u1>& out)
+{
+	size_t first = out.size();
+	const u1* p = buf;
+	const u1* end = buf + length;
+	if(!m_started) {
+		u4 need = (m_encoding == ENC_AUTO) ? DETECT_HEAD : 4;
+		if(!m_head.empty() || length < need) {
+			//too short to tell, keep the head of the text till need bytes.
+			u4 t = need - (u4)m_head.size();
+			if(t > length)
+				t = length;
+			m_head.insert(m_head.end(), buf, buf + t);
+			if(m_head.size() < need)
+				return 0;
+			std::vector<u1> head;
+			head.swap(m_head);
+			feed(&head[0], (u4)head.size(), out);
+			feed(buf + t, length - t, out);
+			return (u4)(out.size() - first);
+		}
+		p += start(buf, length);
+	}
+	while(m_pending_len && p < end) {
+		//finish the cut char with the head of this block.
+		size_t base = out.size();
+		out.resize(base + 32);
+		u1* o0 = &out[base];
+		u1* o = o0;
+		u4 old = m_pending_len;
+		u4 t = (u4)(end - p);
+		if(t > sizeof(m_pending) - old)
+			t = (u4)sizeof(m_pending) - old;
+		memcpy(m_pending + old, p, t);
+		u4 n = convert(m_pending, m_pending + old + t, o, 0);
+		if(n >= old) {
+			p += n - old;
+			m_pending_len = 0;
+		}else{
+			memmove(m_pending, m_pending + n, old + t - n);
+			m_pending_len = old + t - n;
+			p += t;
+		}
+		out.resize(base + (o - o0));
+	}
+	while(p < end) {
+		u4 t = (u4)(end - p);
+		if(t > FEED_BLOCK)
+			t = FEED_BLOCK;
+		size_t base = out.size();
+		out.resize(base + t * 3 + 8);
+		u1* o0 = &out[base];
+		u1* o = o0;
+		u4 n = convert(p, p + t, o, 0);
+		p += n;
+		out.resize(base + (o - o0));
+		if(n < t) {
+			if(p + sizeof(m_pending) <= end && t == FEED_BLOCK)
+				continue;	//cut by the step only
+			m_pending_len = (u4)(end - p);
+			memcpy(m_pending, p, m_pending_len);
+			break;
+		}
+	}
+	return (u4)(out.size() - first);
+}
+
+u4 Transcoder::finish(std::vector<u1>& out)
+{
+	size_t first = out.size();
+	if(!m_started && !m_head.empty()) {
+		//a short text, all in the head.
+		std::vector<u1> head;
+		head.swap(m_head);
+		u4 skip = start(&head[0], (u4)head.size());
+		feed(&head[0] + skip, (u4)head.size() - skip, out);
+	}
+	if(m_pending_len) {
+		size_t base = out.size();
+		out.resize(base + m_pending_len * 3 + 8);
+		u1* o0 = &out[base];
+		u1* o = o0;
+		convert(m_pending, m_pending + m_pending_len, o, 1);
+		m_pending_len = 0;
+		out.resize(base + (o - o0));
+	}
+	return (u4)(out.size() - first);
+}
+
+u1* Transcoder::toUtf8(u1* buf, u4 length, int encoding, std::vector<u1>& storage, u4* utf8_length)
+{
+	if(encoding == ENC_AUTO)
+		encoding = detect(buf, length);
+	if(encoding == ENC_UTF8) {
+		*utf8_length = length;
+		return buf;
+	}
+	Transcoder tr(encoding);
+	storage.clear();
+	tr.feed(buf, length, storage);
+	tr.finish(storage);
+	*utf8_length = (u4)storage.size();
+	storage.push_back(0);
+	return &storage[0];
+}
+
+int Transcoder::detect(const u1* buf, u4 length)
+{
+	if(length >= 3 && buf[0] == 0xEF && buf[1] == 0xBB && buf[2] == 0xBF)
+		return ENC_UTF8;
+	if(length >= 2 && buf[0] == 0xFF && buf[1] == 0xFE)
+		return ENC_UTF16LE;
+	if(length >= 2 && buf[0] == 0xFE && buf[1] == 0xFF)
+		return ENC_UTF16BE;
+	if(length > DETECT_SAMPLE)
+		length = DETECT_SAMPLE;
+	//UTF-16 without BOM, the high byte of ASCII is 0.
+	u4 zeros[2] = {0, 0};
+	for(u4 i = 0; i + 1 < length; i += 2) {
+		zeros[0] += !buf[i];
+		zeros[1] += !buf[i + 1];
+	}
+	u4 units = length / 2;
+	if(units >= 4) {
+		if(zeros[1] * 4 > units && zeros[0] * 16 < zeros[1])
+			return ENC_UTF16LE;
+		if(zeros[0] * 4 > units && zeros[1] * 16 < zeros[0])
+			return ENC_UTF16BE;
+	}
+	//count the wrong sequences as UTF-8 and as GB18030, a char cut by the sample is not wrong.
+	const u1* end = buf + length;
+	u4 utf8_chars = 0, utf8_bad = 0;
+	for(const u1* p = buf; p < end; ) {
+		u1 v = *p;
+		if(v < 0x80) {
+			p++;
+			continue;
+		}
+		u4 len = 0;
+		if((v & 0xE0) == 0xC0 && v >= 0xC2)
+			len = 2;
+		else if((v & 0xF0) == 0xE0)
+			len = 3;
+		else if((v & 0xF8) == 0xF0 && v <= 0xF4)
+			len = 4;
+		u4 k = 1;
+		while(len && k < len && p + k < end && (p[k] & 0xC0) == 0x80)
+			k++;
+		if(len && (k == len || p + k == end)) {
+			utf8_chars++;
+			p += k;
+		}else{
+			utf8_bad++;
+			p++;
+		}
+	}
+	if(!utf8_bad || utf8_bad * 32 < utf8_chars)
+		return ENC_UTF8;	//a few stray bytes in UTF-8 text
+	u4 gb_bad = 0;
+	for(const u1* p = buf; p < end; ) {
+		u1 v = *p;
+		if(v < 0x80) {
+			p++;
+			continue;
+		}
+		if(v == 0x80 || v == 0xFF) {
+			gb_bad++;
+			p++;
+		}else if(p + 1 == end) {
+			break;
+		}else if(p[1] >= 0x40 && p[1] <= 0xFE && p[1] != 0x7F) {
+			p += 2;
+		}else if(p[1] >= 0x30 && p[1] <= 0x39 && (p + 2 >= end
+			|| (p[2] >= 0x81 && p[2] <= 0xFE && (p + 3 == end || (p[3] >= 0x30 && p[3] <= 0x39))))) {
+			p += 4;
+		}else{
+			gb_bad++;
+			p++;
+		}
+	}
+	return gb_bad < utf8_bad ? ENC_GB18030 : ENC_UTF8;
+}
+
+int Transcoder::parseName(const char* name)
+{
+	static const struct {
+		const char* name;
+		int encoding;
+	} names[] = {
+		{"auto", ENC_AUTO},
+		{"utf8", ENC_UTF8},
+		{"utf16", ENC_UTF16LE},
+		{"utf16le", ENC_UTF16LE},
+		{"utf16be", ENC_UTF16BE},
+		{"gbk", ENC_GBK},
+		{"cp936", ENC_GBK},
+		{"gb2312", ENC_GBK},
+		{"gb18030", ENC_GB18030},
+	};
+	//lower case, without '-' and '_'
+	char key[16];
+	u4 n = 0;
+	for(const char* p = name; *p; p++) {
+		if(*p == '-' || *p == '_')
+			continue;
+		if(n + 1 >= sizeof(key))
+			return -1;
+		key[n++] = (*p >= 'A' && *p <= 'Z') ? (char)(*p + 0x20) : *p;
+	}
+	key[n] = 0;
+	for(u4 i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		if(strcmp(key, names[i].name) == 0)
+			return names[i].encoding;
+	}
+	return -1;
+}
+
+} /* End of namespace css */
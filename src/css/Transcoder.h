@@ -0,0 +1,115 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_Transcoder_h
+#define css_Transcoder_h
+
+#include <vector>
+#include "csr_typedefs.h"
+
+namespace css {
+
+/*
+Converts input text to UTF-8 for the segmenter, a block a time.
+- the encoding is given, or detected by the head of the text: a BOM tells UTF-8 and UTF-16;
+  else text mostly valid as UTF-8 is UTF-8, otherwise GB18030 (GBK is a subset of it).
+- GBK and GB18030 go by the tables of gb18030_table.h, UTF-16 by arithmetic;
+  runs of ASCII are copied 8 bytes a time.
+- a byte sequence not in the encoding becomes U+FFFD.
+- a char cut at the end of a block is kept, and finished by the next feed.
+*/
+class Transcoder {
+public:
+	enum {
+		ENC_AUTO = 0,
+		ENC_UTF8,
+		ENC_UTF16LE,
+		ENC_UTF16BE,
+		ENC_GBK,
+		ENC_GB18030
+	};
+	Transcoder(int encoding = ENC_AUTO) { reset(encoding); }
+	/**
+	 *  Start a new text.
+	 */
+	void reset(int encoding = ENC_AUTO) {
+		m_encoding = encoding;
+		m_started = 0;
+		m_pending_len = 0;
+		m_head.clear();
+	}
+	/**
+	 *  @return the encoding in use, ENC_AUTO before the first feed.
+	 */
+	int encoding() const { return m_encoding; }
+	/**
+	 *  Convert a block, append the UTF-8 text to out. A UTF-16 BOM is dropped, UTF-8 is copied as is.
+	 *  @return bytes appended
+	 */
+	u4 feed(const u1* buf, u4 length, std::vector<u1>& out);
+	/**
+	 *  End of the text, a cut char left becomes U+FFFD.
+	 *  @return bytes appended
+	 */
+	u4 finish(std::vector<u1>& out);
+
+	/**
+	 *  The whole text for Segmenter::setBuffer. UTF-8 is not copied: buf itself is returned,
+	 *  buf[length] must be 0. Else the text is converted into storage, NUL terminated.
+	 *  @param encoding ENC_*, ENC_AUTO to detect.
+	 *  @param utf8_length set to the length of the text returned.
+	 *  @return the UTF-8 text
+	 */
+	static u1* toUtf8(u1* buf, u4 length, int encoding, std::vector<u1>& storage, u4* utf8_length);
+	/**
+	 *  Guess the encoding of the text start at buf, by BOM or content.
+	 *  @return ENC_UTF8, ENC_UTF16LE, ENC_UTF16BE or ENC_GB18030
+	 */
+	static int detect(const u1* buf, u4 length);
+	/**
+	 *  @return ENC_* of the name, e.g. "gbk", "utf-16le"; -1 if unknown.
+	 */
+	static int parseName(const char* name);
+protected:
+	/**
+	 *  Detect the encoding if auto, by the text start at head.
+	 *  @return bytes of the BOM to drop
+	 */
+	u4 start(const u1* head, u4 length);
+	/**
+	 *  Convert the chars start in [p, end) to o, stop before a char cut by end unless final.
+	 *  @return bytes consumed
+	 */
+	u4 convert(const u1* p, const u1* end, u1*& o, int final);
+	u4 convertGB(const u1* p, const u1* end, u1*& o, int final);
+	u4 convertUtf16(const u1* p, const u1* end, u1*& o, int final);
+protected:
+	int m_encoding;
+	u1 m_started;	//the BOM is checked
+	u1 m_pending[8];	//a cut char
+	u4 m_pending_len;
+	std::vector<u1> m_head;	//the text before it's started
+};
+
+} /* End of namespace css */
+#endif
@@ -47,10 +47,13 @@ int UnigramDict::load(const char* filename)
 	m_file = csr_mmap_file(filename, 1); // no needs mmap, load into memory is more fast.	
 	if(!m_file)
 		return -1; //can not load dict.
-	csr_offset_t tm_size = csr_mmap_size(m_file);
-	u1* ptr = (u1*)csr_mmap_map(m_file);
-	u1* ptr_end = ptr + tm_size;
-	m_da.set_array(ptr,tm_size);
+	return attach((u1*)csr_mmap_map(m_file), csr_mmap_size(m_file));
+}
+
+int UnigramDict::attach(u1* ptr, csr_offset_t size)
+{
+	m_da.clear();
+	m_da.set_array(ptr,size);
 	return 0;
 }
 
@@ -182,5 +185,14 @@ int UnigramDict::exactMatch(const char* key, int *id)
 	return rs.value;
 }
 
+int UnigramDict::exactMatch(const char* key, u4 key_len, int *id)
+{
+	Darts::DoubleArray::result_pair_type  rs;
+	m_da.exactMatchSearch(key,rs,key_len);
+	if(id)
+		*id = rs.pos;
+	return rs.value;
+}
+
 } /* End of namespace css */
 
@@ -54,6 +54,12 @@ class UnigramDict {
  public:
 
     virtual int load(const char* filename);	
+    /** 
+     *  Use an image already in memory (e.g. a section of a dictionary bundle), which must
+     *  outlive the dictionary.
+     *  @return 0, ok
+     */
+    int attach(u1* ptr, csr_offset_t size);
 	virtual int isLoad();
 
     /** 
@@ -75,6 +81,11 @@ class UnigramDict {
     virtual int save(const char* filename);
 
     virtual int exactMatch(const char* key, int *id = NULL);
+
+    /** 
+     *  Same as above, but key needs not to be NUL terminated.
+     */
+    virtual int exactMatch(const char* key, u4 key_len, int *id);
 protected:
 	Darts::DoubleArray m_da;
 	_csr_mmap_t* m_file;
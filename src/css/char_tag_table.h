@@ -0,0 +1,421 @@
+//generated by script/char_table_build.py, do NOT edit.
+
+//page of each high byte in tag_pages
+const static u1 tag_page_index[256] = {
+0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+2,1,3,3,1,1,1,1,1,1,1,1,1,1,1,1,
+4,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,5,6,
+7,8,7,9,7,7,10,7,11,7,7,7,7,7,7,7,
+7,7,12,13,7,7,7,14,7,7,7,7,7,7,7,7,
+7,7,7,15,7,7,16,7,7,7,7,7,7,7,7,7,
+17,7,7,7,7,7,7,7,7,7,7,7,7,18,7,7,
+7,7,7,7,7,7,19,7,7,7,7,7,7,7,7,20,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,21,
+};
+
+//class letter of each low byte
+const static u1 tag_pages[][256] = {
+{
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'s','w','w','s','s','s','s','w','s','s','s','s','w','s','w','s',
+'m','m','m','m','m','m','m','m','m','m','w','w','s','s','s','w',
+'s','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','e','s','s','s','s','s',
+'s','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','e','s','s','s','s','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'e','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','e','e','e','e','e','u',
+},
+{
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+},
+{
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','w','w','w','w','w','w','w','w',
+'u','u','u','u','u','w','w','w','u','u','u','u','u','u','u','u',
+'u','u','w','w','w','w','w','w','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+},
+{
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+},
+{
+'s','s','w','w','s','s','s','m','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'s','s','s','s','s','s','s','s','s','s','s','s','s','s','s','s',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+},
+{
+'n','c','c','n','c','c','c','n','c','n','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','n','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','n','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','n','c','c','c',
+'c','c','c','c','n','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','n',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','n',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','n','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'n','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','n','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','n','c','n','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','n','c','n','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','n','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','n','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','n','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','n','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','n','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','n','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','n','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','n','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','n','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'n','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','n','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','n','c','c','c','c','c','c','c','c','c',
+},
+{
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','c','c','c','c','c','c','c','c','c','c',
+'c','c','c','c','c','c','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+},
+{
+'u','w','w','s','s','s','s','w','s','s','s','s','w','s','s','s',
+'m','m','m','m','m','m','m','m','m','m','w','s','s','s','s','w',
+'s','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','s','s','s','s','s','s',
+'w','e','e','e','e','e','e','e','e','e','e','e','e','e','e','e',
+'e','e','e','e','e','e','e','e','e','e','s','s','s','s','s','s',
+'s','s','s','s','s','s','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','s','u','u','u','u','u','u','u','u','u','u',
+'u','u','u','u','u','u','u','u','u','u','u','u','u','u','u','u',
+},
+};
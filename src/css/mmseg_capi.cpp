@@ -0,0 +1,279 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <string.h>
+#include <vector>
+#include "SegmenterManager.h"
+#include "Segmenter.h"
+#include "Transcoder.h"
+#include "csr_mutex.h"
+#include "mmseg_capi.h"
+
+using namespace css;
+
+struct mmseg_manager {
+	SegmenterManager mgr;
+	CsrMutex lock;	//guards pool, users and loading
+	std::vector<mmseg_segmenter*> pool;
+	int users;		//segmenters acquired
+	u1 loaded;
+};
+
+struct mmseg_segmenter {
+	mmseg_manager* owner;
+	Segmenter* seg;
+	std::vector<u1> text;	//converted by mmseg_set_text_encoded
+};
+
+//the stats struct is a copy of SegmentStats, keep them the same.
+typedef char mmseg_stats_size_check[sizeof(mmseg_stats_t) == sizeof(SegmentStats) ? 1 : -1];
+typedef char mmseg_encoding_check[MMSEG_ENCODING_GB18030 == Transcoder::ENC_GB18030 ? 1 : -1];
+
+static void free_pool(mmseg_manager* mgr)
+{
+	for(size_t i = 0; i < mgr->pool.size(); i++) {
+		delete mgr->pool[i]->seg;
+		delete mgr->pool[i];
+	}
+	mgr->pool.clear();
+}
+
+extern "C" {
+
+int mmseg_abi_version(void)
+{
+	return MMSEG_ABI_VERSION;
+}
+
+mmseg_manager_t* mmseg_manager_create(void)
+{
+	mmseg_manager* mgr = new mmseg_manager();
+	mgr->users = 0;
+	mgr->loaded = 0;
+	return mgr;
+}
+
+int mmseg_manager_destroy(mmseg_manager_t* mgr)
+{
+	if(!mgr)
+		return MMSEG_ERR_ARG;
+	mgr->lock.lock();
+	if(mgr->users) {
+		mgr->lock.unlock();
+		return MMSEG_ERR_BUSY;
+	}
+	free_pool(mgr);
+	mgr->lock.unlock();
+	delete mgr;
+	return MMSEG_OK;
+}
+
+static int manager_load(mmseg_manager_t* mgr, const char* path, bool force)
+{
+	if(!mgr || !path)
+		return MMSEG_ERR_ARG;
+	int nRet = 0;
+	mgr->lock.lock();
+	if(force && mgr->users)
+		nRet = MMSEG_ERR_BUSY;
+	else if(force || !mgr->loaded) {
+		nRet = mgr->mgr.init(path, SegmenterManager::SEG_METHOD_NGRAM, force);
+		if(nRet == 0) {
+			//pooled segmenters point to the old dictionaries.
+			free_pool(mgr);
+			mgr->loaded = 1;
+		}
+	}
+	mgr->lock.unlock();
+	return nRet;
+}
+
+int mmseg_manager_load(mmseg_manager_t* mgr, const char* path)
+{
+	return manager_load(mgr, path, false);
+}
+
+int mmseg_manager_reload(mmseg_manager_t* mgr, const char* path)
+{
+	return manager_load(mgr, path, true);
+}
+
+int mmseg_manager_stats(mmseg_manager_t* mgr, mmseg_stats_t* stats, unsigned int size)
+{
+	if(!mgr || !stats)
+		return MMSEG_ERR_ARG;
+	SegmentStats snapshot;
+	mgr->mgr.getStats(&snapshot);
+	memcpy(stats, &snapshot, size < sizeof(snapshot) ? size : sizeof(snapshot));
+	return MMSEG_OK;
+}
+
+void mmseg_manager_reset_stats(mmseg_manager_t* mgr)
+{
+	if(mgr)
+		mgr->mgr.resetStats();
+}
+
+mmseg_segmenter_t* mmseg_segmenter_acquire(mmseg_manager_t* mgr)
+{
+	if(!mgr)
+		return NULL;
+	mmseg_segmenter* seg = NULL;
+	mgr->lock.lock();
+	if(mgr->loaded) {
+		if(!mgr->pool.empty()) {
+			seg = mgr->pool.back();
+			mgr->pool.pop_back();
+		}else{
+			seg = new mmseg_segmenter();
+			seg->owner = mgr;
+			seg->seg = mgr->mgr.getSegmenter(false);
+		}
+		mgr->users++;
+	}
+	mgr->lock.unlock();
+	return seg;
+}
+
+void mmseg_segmenter_release(mmseg_segmenter_t* seg)
+{
+	if(!seg)
+		return;
+	mmseg_manager* mgr = seg->owner;
+	seg->seg->flushStats();
+	mgr->lock.lock();
+	mgr->pool.push_back(seg);
+	mgr->users--;
+	mgr->lock.unlock();
+}
+
+int mmseg_set_text(mmseg_segmenter_t* seg, const char* buf, unsigned int length)
+{
+	if(!seg || !buf || buf[length])
+		return MMSEG_ERR_ARG;
+	seg->seg->setBuffer((u1*)buf, length);
+	return MMSEG_OK;
+}
+
+int mmseg_set_text_encoded(mmseg_segmenter_t* seg, const char* buf, unsigned int length, int encoding)
+{
+	if(!seg || !buf || buf[length] || encoding < MMSEG_ENCODING_AUTO || encoding > MMSEG_ENCODING_GB18030)
+		return MMSEG_ERR_ARG;
+	u4 text_length = 0;
+	u1* text = Transcoder::toUtf8((u1*)buf, length, encoding, seg->text, &text_length);
+	seg->seg->setBuffer(text, text_length);
+	return MMSEG_OK;
+}
+
+unsigned int mmseg_next_offsets_omni(mmseg_segmenter_t* seg, unsigned int* offsets, unsigned int max_tokens,
+	unsigned int* omni, unsigned int max_omni, unsigned int* omni_count)
+{
+	if(omni_count)
+		*omni_count = 0;
+	if(!seg)
+		return 0;
+	Segmenter* s = seg->seg;
+	u4 count = 0;
+	u4 omni_n = 0;
+	if(!omni || !omni_count)
+		max_omni = 0;
+	while(1) {
+		//omni tokens of the last token, left ones are taken by the next call.
+		if(max_omni) {
+			OmniItem items[64];
+			while(omni_n < max_omni) {
+				u4 room = max_omni - omni_n;
+				u4 n = s->popOmniTokens(items, room < 64 ? room : 64);
+				if(!n)
+					break;
+				for(u4 i = 0; i < n; i++) {
+					omni[omni_n*2] = items[i].offset;
+					omni[omni_n*2+1] = items[i].offset + items[i].len;
+					omni_n++;
+				}
+			}
+			if(omni_n == max_omni)
+				break;
+		}
+		if(count == max_tokens)
+			break;
+		u2 len = 0, symlen = 0;
+		const u1* tok = s->peekToken(len, symlen);
+		if(!tok || !*tok || !len)
+			break;
+		u4 start = (u4)s->getOffset();
+		s->popToken(len);
+		offsets[count*2] = start;
+		offsets[count*2+1] = start + len;
+		count++;
+	}
+	if(omni_count)
+		*omni_count = omni_n;
+	return count;
+}
+
+unsigned int mmseg_next_offsets(mmseg_segmenter_t* seg, unsigned int* offsets, unsigned int max_tokens)
+{
+	return mmseg_next_offsets_omni(seg, offsets, max_tokens, NULL, 0, NULL);
+}
+
+unsigned int mmseg_next_tokens(mmseg_segmenter_t* seg, mmseg_token_t* tokens, unsigned int max_tokens)
+{
+	if(!seg || !tokens)
+		return 0;
+	u4 count = 0;
+	TokenInfo info;
+	while(count < max_tokens && seg->seg->nextToken(info)) {
+		mmseg_token_t& tok = tokens[count++];
+		tok.offset = info.offset;
+		tok.length = info.length;
+		tok.char_offset = info.char_offset;
+		tok.char_length = info.char_length;
+		tok.text = (const char*)info.text;
+		tok.text_length = info.text_length;
+		tok.replaced = info.replaced;
+	}
+	return count;
+}
+
+unsigned int mmseg_segment(mmseg_segmenter_t* seg, const char* buf, unsigned int length,
+	unsigned int* offsets, unsigned int max_tokens)
+{
+	if(!seg || !buf || buf[length] || !offsets)
+		return 0;
+	//short texts skip the stats flush and tracing, they are flushed by mmseg_segmenter_release.
+	if(length <= Segmenter::QUERY_MAX_LENGTH)
+		return seg->seg->segmentQuery((u1*)buf, length, offsets, max_tokens);
+	if(mmseg_set_text(seg, buf, length) != MMSEG_OK)
+		return 0;
+	return mmseg_next_offsets_omni(seg, offsets, max_tokens, NULL, 0, NULL);
+}
+
+const char* mmseg_thesaurus(mmseg_segmenter_t* seg, const char* word, unsigned int length)
+{
+	if(!seg || !word || length > 0xFFFF)
+		return NULL;
+	return seg->seg->thesaurus(word, (u2)length);
+}
+
+} /* extern "C" */
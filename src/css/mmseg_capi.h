@@ -0,0 +1,173 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef css_mmseg_capi_h
+#define css_mmseg_capi_h
+
+/*
+The C API of libmmseg, for bindings and FFI users.
+- handles are opaque, the layout of the C++ classes is not part of the ABI.
+- offsets are byte offsets into the caller's buffer, (start, end) pairs of unsigned int.
+- a manager can be shared by threads; a segmenter is used by one thread at a time.
+Check mmseg_abi_version() against MMSEG_ABI_VERSION when loaded dynamically.
+*/
+
+#define MMSEG_ABI_VERSION	1
+
+#define MMSEG_OK			0
+#define MMSEG_ERR_ARG		-100	/* NULL handle, or buffer not NUL terminated */
+#define MMSEG_ERR_BUSY		-101	/* segmenters are still acquired */
+#define MMSEG_ERR_NOT_LOADED	-102
+
+/* encodings of mmseg_set_text_encoded */
+#define MMSEG_ENCODING_AUTO		0	/* by BOM, else UTF-8 or GB18030 by content */
+#define MMSEG_ENCODING_UTF8		1
+#define MMSEG_ENCODING_UTF16LE	2
+#define MMSEG_ENCODING_UTF16BE	3
+#define MMSEG_ENCODING_GBK		4
+#define MMSEG_ENCODING_GB18030	5
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mmseg_manager mmseg_manager_t;
+typedef struct mmseg_segmenter mmseg_segmenter_t;
+
+/*
+Counters of the segmenters of a manager, see css::SegmentStats.
+Fields are only appended in later versions, the size passed to mmseg_manager_stats tells
+how many the caller knows.
+*/
+typedef struct {
+	unsigned long long bytes;
+	unsigned long long chars;
+	unsigned long long tokens;
+	unsigned long long chunks;
+	unsigned long long positions;
+	unsigned long long candidates;
+	unsigned long long candidates_max;
+	unsigned long long rules[4];
+	unsigned long long find_hits;
+	unsigned long long hits;
+	unsigned long long synonym_lookups;
+	unsigned long long synonym_hits;
+	unsigned long long thesaurus_lookups;
+	unsigned long long thesaurus_hits;
+	unsigned long long lookup_ns;
+	unsigned long long tokenize_ns;
+} mmseg_stats_t;
+
+/*
+A token with its place in the source, see css::TokenInfo.
+*/
+typedef struct {
+	unsigned int offset;		/* bytes */
+	unsigned int length;
+	unsigned int char_offset;	/* UTF-16 code units */
+	unsigned int char_length;
+	const char* text;			/* the synonym if replaced, else points into the buffer */
+	unsigned int text_length;
+	int replaced;
+} mmseg_token_t;
+
+int mmseg_abi_version(void);
+
+mmseg_manager_t* mmseg_manager_create(void);
+/**
+ *  Free the manager, all its segmenters should be released first.
+ *  @return 0, ok; MMSEG_ERR_BUSY, segmenters are acquired, the manager is kept
+ */
+int mmseg_manager_destroy(mmseg_manager_t* mgr);
+/**
+ *  Load the dictionaries of path, a directory or a bundle. Only the 1st load takes effect.
+ *  @return 0, ok; else the error code of SegmenterManager::init
+ */
+int mmseg_manager_load(mmseg_manager_t* mgr, const char* path);
+/**
+ *  Load the dictionaries again, e.g. after they are replaced on disk.
+ *  @return 0, ok; MMSEG_ERR_BUSY, segmenters are acquired
+ */
+int mmseg_manager_reload(mmseg_manager_t* mgr, const char* path);
+/**
+ *  @param size sizeof(mmseg_stats_t) of the caller.
+ *  @return 0, ok
+ */
+int mmseg_manager_stats(mmseg_manager_t* mgr, mmseg_stats_t* stats, unsigned int size);
+void mmseg_manager_reset_stats(mmseg_manager_t* mgr);
+
+/**
+ *  Take a segmenter from the pool of the manager, thread-safe.
+ *  @return NULL, the manager is not loaded.
+ */
+mmseg_segmenter_t* mmseg_segmenter_acquire(mmseg_manager_t* mgr);
+void mmseg_segmenter_release(mmseg_segmenter_t* seg);
+
+/**
+ *  Segment buf in place, buf[length] must be 0 and buf kept until the text is done.
+ *  @return 0, ok
+ */
+int mmseg_set_text(mmseg_segmenter_t* seg, const char* buf, unsigned int length);
+/**
+ *  As mmseg_set_text, buf in one of MMSEG_ENCODING_*. Other than UTF-8, the text is converted
+ *  into the segmenter and offsets are of the UTF-8 text; UTF-8 is segmented in place.
+ *  @return 0, ok
+ */
+int mmseg_set_text_encoded(mmseg_segmenter_t* seg, const char* buf, unsigned int length, int encoding);
+/**
+ *  Fill offsets with the next (start, end) pairs, up to max_tokens pairs.
+ *  @return the count of pairs, 0 when the text is done.
+ */
+unsigned int mmseg_next_offsets(mmseg_segmenter_t* seg, unsigned int* offsets, unsigned int max_tokens);
+/**
+ *  As mmseg_next_offsets, also fill omni with the omni tokens (other words of the dictionary
+ *  overlapping the tokens), as (start, end) pairs, up to max_omni pairs.
+ *  @param omni_count set to the count of omni pairs.
+ *  @return the count of token pairs, the text is done when both counts are 0.
+ */
+unsigned int mmseg_next_offsets_omni(mmseg_segmenter_t* seg, unsigned int* offsets, unsigned int max_tokens,
+	unsigned int* omni, unsigned int max_omni, unsigned int* omni_count);
+/**
+ *  Fill tokens with the next tokens, up to max_tokens.
+ *  @return the count of tokens, 0 when the text is done.
+ */
+unsigned int mmseg_next_tokens(mmseg_segmenter_t* seg, mmseg_token_t* tokens, unsigned int max_tokens);
+/**
+ *  Segment the whole buf, as mmseg_set_text. A text has at most length tokens, so offsets of
+ *  2 * length fits all. Texts up to 256 bytes, e.g. search queries, skip the per document setup:
+ *  they are never traced, and their counters reach mmseg_manager_stats by mmseg_segmenter_release.
+ *  @return the count of pairs; if it's max_tokens, more might follow by mmseg_next_offsets.
+ */
+unsigned int mmseg_segment(mmseg_segmenter_t* seg, const char* buf, unsigned int length,
+	unsigned int* offsets, unsigned int max_tokens);
+/**
+ *  Thesaurus items of the word, NUL separated, end with an empty string.
+ *  @return NULL, no item.
+ */
+const char* mmseg_thesaurus(mmseg_segmenter_t* seg, const char* word, unsigned int length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
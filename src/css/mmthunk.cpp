@@ -36,24 +36,14 @@ void MMThunk::setItems(i4 idx,
                        UnigramDict* dict) {
   if (m_max_length < idx)
     m_max_length = idx;
-
-  u4 index = (idx % CHUNK_BUFFER_SIZE) + base_offset;
-  item_info* item = item_list.alloc();
-  item->freq = 0;
-  item->items.clear();
+  m_item_begin[idx] = (u4)m_lens.size();
+  m_item_count[idx] = rs_count;
+  m_item_freq[idx] = 0;
   for (u2 i = 0; i < rs_count; i++) {
-    //if (dict->old_version()) {
-      item->freq = results[i].value;
-    /*
-	} else {
-      item->freq += dict->FindFreqByOffset(results[i].value);
-    }
-	*/
-    item->items.push_back(results[i].length);
-    //if(i == rs_count - 1)
-    //	item->length = results[i].length;
+    //the longest comes last.
+    m_item_freq[idx] = results[i].value;
+    m_lens.push_back(results[i].length);
   }
-  m_charinfos[idx] = item;
   return;
 }
 
@@ -64,29 +54,17 @@ void MMThunk::setKwItems(i4 idx,
     UnigramDict* dict) {
   if (m_max_length < idx)
     m_max_length = idx;
-  u4 index = (idx % CHUNK_BUFFER_SIZE) + base_offset;
-  item_info* item = item_list.alloc();
-  item->items.clear();
-  for (u2 i = 0; i < rs_count; i++) {
-    //if (dict->old_version()) {
-      item->freq = results[i].value;
-    /*
-    } else {
-      item->freq += dict->FindFreqByOffset(results[i].value);
-    }
-	*/
-    item->items.push_back(results[i].length);
-    //if(i == rs_count - 1)
-    //	item->length = results[i].length;
-  }
-  m_kwinfos[idx] = item;
+  m_kw_begin[idx] = (u4)m_kw_lens.size();
+  m_kw_count[idx] = rs_count;
+  for (u2 i = 0; i < rs_count; i++)
+    m_kw_lens.push_back(results[i].length);
   return;
 }
 
 u1* MMThunk::peekToken(u2& length) {
   length = 0;
-  if (!tokens.empty()) {
-    length = tokens.front();
+  if (m_token_head < tokens.size()) {
+    length = tokens[m_token_head];
   }
   return NULL;
 }
@@ -95,68 +73,68 @@ u4 MMThunk::popOmniToken(u4 maxoffset, u2& length) {
   //the token peeked order just as same as main token.
   //@return the offset, @param length the token length.
   //@param if offset is larger than max_offset, just keep item and return.
-  u4 val = 0;
   length = 0;
-
-  if (q_omni_tokens.empty())
-    return val;
-
-  const OmniItem& item = q_omni_tokens.top();
-  length = item.len;
-  val = item.offset;
-  if (val > maxoffset) {
-    length = 0;
-    return val;
-  }
-  // peekToken
-  {
-    u2 tLen = 0;
-    peekToken(tLen);
-    if (val == maxoffset && length == tLen) {
-      q_omni_tokens.pop(); //skip current element.
-      return popOmniToken(maxoffset, length);
+  u2 tLen = 0;
+  peekToken(tLen);
+  while (m_omni_pos < m_omni_end) {
+    u8 bits = m_omni_bits[m_omni_pos];
+    if (!bits) {
+      m_omni_pos++;
+      continue;
     }
+    if (m_omni_pos > maxoffset)
+      return m_omni_pos;
+    if (m_omni_pos == maxoffset && m_tail && m_token_head == tokens.size())
+      return 0; //the main token here is decided by the next window.
+    u2 len = omni_lowest_bit(bits);
+    m_omni_bits[m_omni_pos] = bits & (bits - 1); //consume it.
+    if (m_omni_pos == maxoffset && len == tLen)
+      continue; //skip current element, same as main token.
+    length = len;
+    return m_omni_pos;
   }
+  return 0;
+}
 
-  q_omni_tokens.pop();
-  while (false == q_omni_tokens.empty()) {
-    const OmniItem& item_next = q_omni_tokens.top();
-    if (val == item_next.offset && length == item_next.len)
-      q_omni_tokens.pop();
-    else
-      break; //if not continues dump, break it!
+u4 MMThunk::popOmniTokens(u4 maxoffset, OmniItem* items, u4 max_items) {
+  u4 count = 0;
+  u2 length = 0;
+  while (count < max_items) {
+    u4 offset = popOmniToken(maxoffset, length);
+    if (!length)
+      break;
+    items[count].offset = offset;
+    items[count].len = length;
+    count++;
   }
-  return val;
+  return count;
 }
 
 u2 MMThunk::popupToken() {
   u2 length = 0;
-    if (!tokens.empty()) {
-      length = tokens.front();
+    if (m_token_head < tokens.size()) {
+      length = tokens[m_token_head];
       m_length -= length;
-      tokens.pop();
+      m_token_head++;
+      if (m_token_head == tokens.size()) {
+        tokens.clear();
+        m_token_head = 0;
+      }
     }
   return length;
 }
 
 u1* MMThunk::peekKwToken(u2& pos, u2& length) {
-  if (m_max_length < m_kw_pos)
-    m_max_length = m_kw_pos;
-
-  while (m_kw_pos <= m_max_length) {
+  while (m_kw_pos <= m_kw_end) {
     u4 index = (m_kw_pos % CHUNK_BUFFER_SIZE) + base_offset;
-    //clear kw_word
-    item_info* info_kw = m_kwinfos[index];
-    if (info_kw) {
-      //find the item
-      size_t cnt = info_kw->items.size();
-      if (m_kw_ipos < cnt) {
-        length = info_kw->items[m_kw_ipos];
-        m_kw_ipos++;
-        //found one
-        pos = m_kw_pos;
-        return NULL;
-      }
+    while (m_kw_ipos < m_kw_count[index]) {
+      length = m_kw_lens[m_kw_begin[index] + m_kw_ipos];
+      m_kw_ipos++;
+      if (!length)
+        continue; //taken by a main token.
+      //found one
+      pos = m_kw_pos;
+      return NULL;
     }
     m_kw_pos++;
     m_kw_ipos = 0;
@@ -178,56 +156,62 @@ u2 MMThunk::popupKwToken() {
 }
 
 //do real segment in this function, return token's count
-int MMThunk::Tokenize(int iOmnWeight) {
-#if CHUNK_DEBUG
-  printf("tokenizer:\n");
-  for(u2 i = 0; m_charinfos[i]; i++) {
-    std::vector<u2>::iterator it;
-    for(it = m_charinfos[i]->items.begin();
-        it < m_charinfos[i]->items.end();
-        it++)
-    printf("%d, ", *it);
-    printf("\n");
-  }
-#endif
+int MMThunk::Tokenize(int iOmnWeight, i4 decide_end) {
   // appply rules
   u2 base = 0;
   Chunk chunk(iOmnWeight);
+#if MMSEG_STATS
+  m_stats->chunks++;
+#endif
+  m_omni_end = m_max_length + 1;
+  if (m_omni_end > CHUNK_BUFFER_SIZE)
+    m_omni_end = CHUNK_BUFFER_SIZE;
+  m_tail = 0;
   while (base <= m_max_length) {
-    item_info* info_1st = m_charinfos[base];
-    for (size_t i = 0; i < info_1st->items.size(); i++) {
+    if (decide_end >= 0 && base >= decide_end) {
+      m_tail = 1;
+      break;
+    }
+#if MMSEG_STATS
+    u8 candidates = m_stats->candidates;
+#endif
+    //the words of a position are m_lens[m_item_begin[pos] + i], i < m_item_count[pos].
+    u4 begin_1st = m_item_begin[base];
+    u2 count_1st = m_item_count[base];
+    chunk.omni_bits = &m_omni_bits[base];
+    for (u2 i = 0; i < count_1st; i++) {
       if (i == 0)
-        chunk.pushToken(info_1st->items[i], info_1st->freq);
+        chunk.pushToken(m_lens[begin_1st + i], m_item_freq[base]);
       else
-        chunk.pushToken(info_1st->items[i], 0);
+        chunk.pushToken(m_lens[begin_1st + i], 0);
       //Chunk L1_chunk = chunk;
-      u2 idx_2nd = info_1st->items[i] + base;
+      u2 idx_2nd = m_lens[begin_1st + i] + base;
       //check bound
-      item_info* info_2nd = NULL;
+      u2 count_2nd = 0;
       if (idx_2nd < m_max_length)
-        info_2nd = m_charinfos[idx_2nd];
-      if (info_2nd) {
-        for (size_t j = 0; j < info_2nd->items.size(); j++) {
+        count_2nd = m_item_count[idx_2nd];
+      if (count_2nd) {
+        u4 begin_2nd = m_item_begin[idx_2nd];
+        for (u2 j = 0; j < count_2nd; j++) {
           if (j == 0)
-            chunk.pushToken(info_2nd->items[j], info_2nd->freq);
+            chunk.pushToken(m_lens[begin_2nd + j], m_item_freq[idx_2nd]);
           else
-            chunk.pushToken(info_2nd->items[j], 1);
-          u2 idx_3rd = info_2nd->items[j] + idx_2nd;
-          if (idx_3rd < m_max_length && m_charinfos[idx_3rd]) {
-            u2 idx_4th =
-                m_charinfos[idx_3rd]->items[m_charinfos[idx_3rd]->items.size()
-                    - 1];
-            if (m_charinfos[idx_3rd]->items.size() == 1)
-              chunk.pushToken(idx_4th, m_charinfos[idx_3rd]->freq);
+            chunk.pushToken(m_lens[begin_2nd + j], 1);
+          u2 idx_3rd = m_lens[begin_2nd + j] + idx_2nd;
+          if (idx_3rd < m_max_length && m_item_count[idx_3rd]) {
+            u2 count_3rd = m_item_count[idx_3rd];
+            u2 idx_4th = m_lens[m_item_begin[idx_3rd] + count_3rd - 1];
+            if (count_3rd == 1)
+              chunk.pushToken(idx_4th, m_item_freq[idx_3rd]);
             else
               chunk.pushToken(idx_4th, 1);
             //push path.
-            pushChunk(chunk);
+            pushChunk(chunk, base);
             //pop 3part
             chunk.popup();
           } else {
             //no 3part, push path
-            pushChunk(chunk);
+            pushChunk(chunk, base);
           }
           //pop 2part
           chunk.popup();
@@ -235,7 +219,7 @@ int MMThunk::Tokenize(int iOmnWeight) {
       }//end if
       else {
         //no 2part ,push path
-        pushChunk(chunk);
+        pushChunk(chunk, base);
       }
       //pop 1part
       chunk.popup();
@@ -243,47 +227,66 @@ int MMThunk::Tokenize(int iOmnWeight) {
     //find the last pharse
     //reset. rebase
     u2 tok_len = m_queue.getToken();
+    if (m_trace)
+      traceDecision(base, tok_len);
+#if MMSEG_STATS
+    if (m_queue.m_rule) {
+      m_stats->positions++;
+      m_stats->rules[m_queue.m_rule - 1]++;
+      candidates = m_stats->candidates - candidates;
+      if (candidates > m_stats->candidates_max)
+        m_stats->candidates_max = candidates;
+    }
+#endif
     if (tok_len) {
       pushToken(tok_len, base); //tokens.push_back(tok_len);
     } else
       break;
 
-    //handle the omni word!
-    {
-      std::vector<u4>::iterator it;
-      u4 val = 0;
-      for (it = chunk.omni_tokens.begin(); it < chunk.omni_tokens.end(); it++) {
-        val = ((u4) *it);
-        u2 length = HIWORD(val);
-        u4 offset = LOWORD(val) + base;
-        //if(offset == base && length == tok_len)
-        //	continue;
-        q_omni_tokens.push(OmniItem(offset, length));
-#if CHUNK_DEBUG
-        {
-          printf("omni:[%d,%d],", offset, length);
-        }
-#endif
-      } // end for
-    }
     m_queue.reset();
     chunk.reset();
     base += tok_len;
   }//end while
+  m_kw_end = m_tail ? base - 1 : m_max_length;
   return 0;
 }
 
-void MMThunk::pushChunk(Chunk& ck) {
-#if CHUNK_DEBUG
-  printf("Pushing: ");
-  for(size_t i = 0; i<ck.tokens.size(); i++) {
-    printf("%d,",ck.tokens[i]);
-  }
-  printf("\n");
+void MMThunk::pushChunk(Chunk& ck, u2 base) {
+#if MMSEG_STATS
+  m_stats->candidates++;
 #endif
+  if (m_trace)
+    traceChunk(ck, base);
   m_queue.push(ck);
 }
 
+void MMThunk::traceChunk(Chunk& ck, u2 base) {
+  TraceRecord* rec = m_trace->next();
+  rec->type = TraceRecord::CANDIDATE;
+  rec->pos = base;
+  rec->value = ck.total_length;
+  rec->count = ck.count;
+  for (u1 i = 0; i < 3; i++) {
+    rec->lens[i] = i < ck.count ? ck.tokens[i] : 0;
+    rec->freqs[i] = i < ck.count ? ck.freqs[i] : 0;
+  }
+  rec->rule = 0;
+  rec->avl = ck.get_avl();
+  rec->var = ck.count > 1 ? ck.get_avg() : 0;
+  rec->freedom = ck.get_free();
+  m_trace->commit(rec);
+}
+
+void MMThunk::traceDecision(u2 base, u2 tok_len) {
+  TraceRecord* rec = m_trace->next();
+  rec->type = TraceRecord::DECISION;
+  rec->pos = base;
+  rec->value = tok_len;
+  rec->count = (u1)m_queue.m_chunks.size();
+  rec->rule = m_queue.m_rule;
+  m_trace->commit(rec);
+}
+
 void pushOmniToken(u2 aSize, i4 base) {
   //FAST check existence -> this Omni Token is a pre-document sized buffer
   //when popup, should move the pointer ,and return prev token's OmniToken.
@@ -291,38 +294,89 @@ void pushOmniToken(u2 aSize, i4 base) {
 }
 
 void MMThunk::pushToken(u2 aSize, i4 base) {
-  tokens.push(aSize);
+  tokens.push_back(aSize);
   m_length += aSize;
   if (base < 0)
     return;
   //clear kw_word
-  item_info* info_kw = m_kwinfos[base];
-  if (info_kw) {
-    //find the item
-    std::vector<u2>::iterator it = info_kw->items.begin();
-    for (; it < info_kw->items.end(); it++) {
-      if (*it == aSize) {
-        info_kw->items.erase(it); //find the same item.
-        break;
-      }
+  u2* lens = m_kw_count[base] ? &m_kw_lens[m_kw_begin[base]] : NULL;
+  for (u2 i = 0; i < m_kw_count[base]; i++) {
+    if (lens[i] == aSize) {
+      lens[i] = 0; //find the same item.
+      break;
     }
   }
 }
 
 void MMThunk::reset() {
-  memset(m_charinfos, 0, sizeof(item_info*) * CHUNK_BUFFER_SIZE);
-  memset(m_kwinfos, 0, sizeof(item_info*) * CHUNK_BUFFER_SIZE);
-  item_list.free();
-  while (!tokens.empty()) {
-    tokens.pop();
+  //positions beyond m_max_length are never set.
+  if (m_max_length >= 0) {
+    memset(m_item_count, 0, sizeof(u2) * (m_max_length + 1));
+    memset(m_kw_count, 0, sizeof(u2) * (m_max_length + 1));
   }
-  q_omni_tokens = std::priority_queue<OmniItem,std::vector<OmniItem>, OmniItemCmp>();
-  //q_omni_tokens.empty();
+  m_lens.clear();
+  m_kw_lens.clear();
+  tokens.clear();
+  m_token_head = 0;
+  //only the range touched by last Tokenize is dirty.
+  memset(m_omni_bits, 0, sizeof(u8) * m_omni_end);
+  m_omni_pos = m_omni_end = 0;
   m_queue.reset();
 
   m_max_length = -1;
   m_length = 0;
+  m_tail = 0;
+  m_kw_pos = m_kw_ipos = 0;
+  m_kw_end = -1;
+}
+
+void MMThunk::slide(u2 shift) {
+  if (!shift || shift > m_max_length) {
+    reset();
+    return;
+  }
+  //move the tail to the front, the lengths are packed down in the same order.
+  u4 lens_end = 0;
+  u4 kw_end = 0;
+  for (i4 from = shift; from <= m_max_length; from++) {
+    i4 to = from - shift;
+    u2 n = m_item_count[from];
+    for (u2 i = 0; i < n; i++)
+      m_lens[lens_end + i] = m_lens[m_item_begin[from] + i];
+    m_item_begin[to] = lens_end;
+    m_item_count[to] = n;
+    m_item_freq[to] = m_item_freq[from];
+    lens_end += n;
+    n = m_kw_count[from];
+    for (u2 i = 0; i < n; i++)
+      m_kw_lens[kw_end + i] = m_kw_lens[m_kw_begin[from] + i];
+    m_kw_begin[to] = kw_end;
+    m_kw_count[to] = n;
+    kw_end += n;
+  }
+  m_lens.resize(lens_end);
+  m_kw_lens.resize(kw_end);
+  i4 tail = m_max_length + 1 - shift;
+  memset(&m_item_count[tail], 0, sizeof(u2) * shift);
+  memset(&m_kw_count[tail], 0, sizeof(u2) * shift);
+  //omni tokens of the tail, found by the decisions before it.
+  if (m_omni_end > shift) {
+    memmove(m_omni_bits, &m_omni_bits[shift], sizeof(u8) * (m_omni_end - shift));
+    memset(&m_omni_bits[m_omni_end - shift], 0, sizeof(u8) * shift);
+    m_omni_end -= shift;
+  } else {
+    memset(m_omni_bits, 0, sizeof(u8) * m_omni_end);
+    m_omni_end = 0;
+  }
+  m_omni_pos = 0;
+  tokens.clear();
+  m_token_head = 0;
+  m_queue.reset();
+  m_max_length = tail - 1;
+  m_length = 0;
+  m_tail = 0;
   m_kw_pos = m_kw_ipos = 0;
+  m_kw_end = -1;
 }
 
 }
@@ -30,9 +30,18 @@
 #include <math.h>
 #include "UnigramDict.h"
 #include "freelist.h"
+#include "SegmentStats.h"
+#include "SegmentTrace.h"
 
+#ifndef CHUNK_BUFFER_SIZE
 #define CHUNK_BUFFER_SIZE 1024
-#define CHUNK_DEBUG		0
+#endif
+/*
+a decision at a position looks at the words starting up to 2 words after it, a word is at
+most MAX_TOKEN_LENGTH (36) bytes. when a long text fills the window, positions within this
+distance of the end are left undecided and carried to the next window.
+*/
+#define CHUNK_LOOKAHEAD 72
 
 namespace css {
 	
@@ -43,42 +52,48 @@ namespace css {
 		OmniItem(u4 o = 0, u2 l = 0):offset(o),len(l){}
 	};
 
-	struct OmniItemCmp
-	{
-		bool operator()(OmniItem a,OmniItem b){
-			if (a.offset == b.offset)
-				return a.len>b.len;
-			return a.offset>b.offset;
-		}
-	};
+	/*
+	omni tokens are kept in a position x length bitmap, one u8 per chunk position,
+	bit n set means a token of n bytes starts there. a token can not longer than 63 bytes,
+	MAX_TOKEN_LENGTH of segmenter is 36.
+	*/
+	#define OMNI_MAX_TOKEN_LENGTH 63
+
+	inline u2 omni_lowest_bit(u8 v) {
+#if defined(__GNUC__)
+		return (u2)__builtin_ctzll(v);
+#else
+		u2 n = 0;
+		while(!(v & 1)) { v >>= 1; n++; }
+		return n;
+#endif
+	}
 
   class Chunk{
 	public:
-		Chunk(int iOmnWeight):
+		Chunk(int iOmnWeight, u8* omni_bits = NULL):
 		  m_free_score(0.0),
 		  total_length(0),
-		  m_iOmnWeight(iOmnWeight)
+		  m_iOmnWeight(iOmnWeight),
+		  count(0),
+		  omni_bits(omni_bits)
 		  {}
 
 		float m_free_score;
 		int total_length;
 		int m_iOmnWeight;
-		std::vector<u2> tokens;
-		std::vector<u2> freqs;
-		std::vector<u4> omni_tokens; //dirty hacking -> the low word -> offset; the high -> len
+		//a chunk is at most 3 words, kept in place to be copied without allocation.
+		u2 tokens[3];
+		u2 freqs[3];
+		u1 count;
+		u8* omni_bits; //the bitmap row of chunk's 1st char, owned by MMThunk.
 		inline void pushToken(u2 len, u2 freq) {
-#if CHUNK_DEBUG
-			printf("pt[%d]:%d, %d;\t", total_length, len, freq);
-#endif
-			tokens.push_back(len);
-			freqs.push_back(freq);
-			if(freq >= m_iOmnWeight) {
-				//push to ...
-				//thus, I can simply append base to the number
-				u4 v = MAKEDWORD(len, total_length);
-				//this vector will no more than 15 elmenet, just a for loop existance check.
-				if(std::find(omni_tokens.begin(), omni_tokens.end(), v) == omni_tokens.end())
-					omni_tokens.push_back(v);
+			tokens[count] = len;
+			freqs[count] = freq;
+			count++;
+			if(freq >= m_iOmnWeight && omni_bits && len <= OMNI_MAX_TOKEN_LENGTH) {
+				//set bit is the existence check.
+				omni_bits[total_length] |= ((u8)1) << len;
 			}
 			
 			total_length += len;
@@ -87,39 +102,34 @@ namespace css {
 		inline float get_free(){
 			//m_free_score
 			float score = 0.0;
-			std::vector<u2>::iterator it;
 			float freq = 0;
-			for(it = freqs.begin(); it < freqs.end(); it++){
-				freq = ((float)*it) + 1;
+			for(u1 i = 0; i < count; i++){
+				freq = ((float)freqs[i]) + 1;
 				score+= log(freq) * 100;
 			}
 			return score;
 		}
 		inline float get_avl() {
-			float avg = (float)1.0*total_length/tokens.size();
+			float avg = (float)1.0*total_length/count;
 			return avg;
 		}
 		inline float get_avg(){
-			float avg = (float)1.0*total_length/tokens.size();
-			std::vector<u2>::iterator it;
+			float avg = (float)1.0*total_length/count;
 			float total = 0;
-			for(it = tokens.begin(); it < tokens.end(); it++){
-				float diff = ((*it) - avg);
+			for(u1 i = 0; i < count; i++){
+				float diff = (tokens[i] - avg);
 				total += diff*diff;
 			}
-			return (float)1.0*total/(tokens.size() -1);
+			return (float)1.0*total/(count -1);
 		}
 		inline void popup() {
-			if(tokens.size()) {
-				total_length -= tokens.back();
-				tokens.pop_back();
-				freqs.pop_back();
+			if(count) {
+				count--;
+				total_length -= tokens[count];
 			}
 		}
 		inline void reset() {
-			tokens.clear();
-			freqs.clear();
-			omni_tokens.clear();
+			count = 0;
 			total_length = 0;
 		}
 	};
@@ -128,7 +138,7 @@ namespace css {
   class ChunkQueue
 	{
 	public:
-		ChunkQueue():max_length(0) {};
+		ChunkQueue():max_length(0), m_rule(0) {};
 	public:
 		void push(Chunk& ck) {
 			if(ck.total_length < max_length)
@@ -143,17 +153,9 @@ namespace css {
 			size_t num_chunk = m_chunks.size();
 			if(!num_chunk)
 				return 0;
+			m_rule = 1;
 			if(num_chunk == 1)
 				return m_chunks[0].tokens[0];
-			//debug use->dump chunk
-#if CHUNK_DEBUG
-			printf("GetToken:\n");
-			for(size_t i = 0; i<num_chunk; i++){
-				for(size_t j = 0; j< m_chunks[i].tokens.size();j++)
-					printf("%d,",m_chunks[i].tokens[j]);
-				printf("\n");
-			}
-#endif			
 			//do filter
 			//apply rule 2
 			float avg_length = 0;
@@ -172,6 +174,7 @@ namespace css {
 					k_ptr++;
 				}
 			}
+			m_rule = 2;
 			if((k_ptr - remains) == 1)
 				return m_chunks[remains[0]].tokens[0]; //match by rule2
 			//apply rule 3
@@ -191,8 +194,10 @@ namespace css {
 					k_ptr_r3++;
 				}
 			}
+			m_rule = 3;
 			if((k_ptr_r3 - remains_r3) == 1)
 				return m_chunks[remains_r3[0]].tokens[0]; //match by rule3 min avg_length
+			m_rule = 4;
 			//apply r4 max freedom
 			float max_score = 0.0;
 			size_t idx = -1;
@@ -210,38 +215,26 @@ namespace css {
 		inline void reset() {
 			m_chunks.clear();
 			max_length = 0;
+			m_rule = 0;
 		};
 	public:
 		std::vector<Chunk> m_chunks;
 		i4 max_length;
+		u1 m_rule; //the rule made the decision of last getToken, 1-4.
 	};
 
-	class item_info
-	{
-	public:
-		item_info():
-		  //length(0),
-		  freq(0){
-		};
-		
-	public:
-		//u4 length;
-		u4 freq;
-		std::vector<u2> items;
-	};
-
-	
 	class MMThunk
 	{
-	protected:
-		std::priority_queue<OmniItem,std::vector<OmniItem>, OmniItemCmp> q_omni_tokens;
-
 	public:
-		MMThunk():base_offset(0), m_max_length(-1), m_length(0)
+		MMThunk():m_stats(NULL), m_trace(NULL), base_offset(0), m_token_head(0), m_kw_end(-1),
+			m_max_length(-1), m_length(0), m_tail(0), m_omni_pos(0), m_omni_end(0)
 		{
-			memset(m_charinfos, 0, sizeof(item_info*)*CHUNK_BUFFER_SIZE);
-			memset(m_kwinfos, 0, sizeof(item_info*)*CHUNK_BUFFER_SIZE);
-			item_list.set_size(CHUNK_BUFFER_SIZE*2);
+			memset(m_item_count, 0, sizeof(m_item_count));
+			memset(m_kw_count, 0, sizeof(m_kw_count));
+			memset(m_omni_bits, 0, sizeof(m_omni_bits));
+			m_lens.reserve(CHUNK_BUFFER_SIZE * 2);
+			m_kw_lens.reserve(CHUNK_BUFFER_SIZE);
+			tokens.reserve(CHUNK_BUFFER_SIZE);
 		};
 		~MMThunk() {};
 		
@@ -259,30 +252,63 @@ namespace css {
 		u2 popupToken();
 
 		u4 popOmniToken(u4 maxoffset, u2& length);
+		//bulk version of popOmniToken, @return the count of items filled.
+		u4 popOmniTokens(u4 maxoffset, OmniItem* items, u4 max_items);
 
 		u1* peekKwToken(u2& pos, u2& length);
 		u2 popupKwToken();
 
-		int Tokenize(int iOmnWeight);
+		/**
+		 *  @param decide_end positions from it are left undecided, for the next window. -1, decide all.
+		 */
+		int Tokenize(int iOmnWeight, i4 decide_end = -1);
 		void pushToken(u2 aSize, i4 base);
 		void pushOmniToken(u2 aSize, i4 base);
 		
 		void reset();
+		/**
+		 *  Start the next window: drop the positions before shift, the undecided ones
+		 *  move to the front. The tokens of the last window should be all popped.
+		 */
+		void slide(u2 shift);
+		//the last Tokenize left positions undecided.
+		u1 hasTail() { return m_tail; };
 		u4 length() { return m_length; };
+	public:
+		SegmentStats* m_stats; //owned by Segmenter, must be set.
+		TraceRing* m_trace; //not NULL if current document is traced.
 	protected:
 		u2 base_offset;
-		CRFPP::FreeList<item_info> item_list;
-		item_info* m_charinfos[CHUNK_BUFFER_SIZE];
-		std::queue<u2> tokens;
+		/*
+		the lattice, by position: m_item_count[i] word lengths from m_lens[m_item_begin[i]], 0 if not set,
+		m_item_freq[i] the frequence of the longest. positions are set in order, so m_lens is too.
+		the kw words are kept the same way, a length is 0 once a main token took it.
+		*/
+		std::vector<u2> m_lens;
+		u4 m_item_begin[CHUNK_BUFFER_SIZE];
+		u2 m_item_count[CHUNK_BUFFER_SIZE];
+		u4 m_item_freq[CHUNK_BUFFER_SIZE];
+		std::vector<u2> m_kw_lens;
+		u4 m_kw_begin[CHUNK_BUFFER_SIZE];
+		u2 m_kw_count[CHUNK_BUFFER_SIZE];
+		//the decided tokens, from tokens[m_token_head]; emptied once all popped, keeps its buffer.
+		std::vector<u2> tokens;
+		u4 m_token_head;
 		//std::vector<u4> omni_tokens; //dirty hacking -> the low word -> offset; the high -> len
-		item_info* m_kwinfos[CHUNK_BUFFER_SIZE];
 		i4 m_kw_pos;
 		i4 m_kw_ipos;
+		i4 m_kw_end; //last position of the kw tokens to report, the decided part of the window.
 		i4 m_max_length;
 		u4 m_length;
+		u1 m_tail;
 		ChunkQueue m_queue;
+		u8 m_omni_bits[CHUNK_BUFFER_SIZE];
+		u4 m_omni_pos; //read cursor of m_omni_bits
+		u4 m_omni_end; //dirty range of m_omni_bits
 	protected:
-		void pushChunk(Chunk& ck);
+		void pushChunk(Chunk& ck, u2 base);
+		void traceChunk(Chunk& ck, u2 base);
+		void traceDecision(u2 base, u2 tok_len);
 	};
 
 }
@@ -36,26 +36,63 @@ namespace css {
 
 #define MAX_TOKEN_LENGTH 36 //3*5
 
+//UTF-16 code units of the UTF-8 text, each lead byte is one, a 4 bytes char is a surrogate pair.
+static inline u4 utf16_units(const u1* ptr, const u1* end)
+{
+	u4 units = 0;
+	for(; ptr < end; ptr++)
+		units += ((*ptr & 0xC0) != 0x80) + (*ptr >= 0xF0);
+	return units;
+}
+
 int Segmenter::getOffset()
 {
-	return 0; //(int)(m_offset + m_pkg_offset);
+	return (int)(m_buffer_ptr - m_buffer_begin);
+}
+
+u1 Segmenter::nextToken(TokenInfo& info)
+{
+	u2 len = 0, symlen = 0;
+	const u1* tok = peekToken(len, symlen);
+	if(!tok || !*tok || !len)
+		return 0;
+	const u1* begin = m_buffer_ptr;
+	info.offset = (u4)(begin - m_buffer_begin);
+	info.length = len;
+	info.char_offset = m_char_offset;
+	info.char_length = utf16_units(begin, begin + len);
+	info.text = tok;
+	info.text_length = symlen;
+	info.replaced = (tok != begin);
+	popToken(len);
+	return 1;
 }
 
 const char* Segmenter::thesaurus(const char* key, u2 key_len)
 {
 	if(this->m_thesaurus){
-		return this->m_thesaurus->find(key, key_len);
+		const char* thesaurus = this->m_thesaurus->find(key, key_len);
+#if MMSEG_STATS
+		m_stats.thesaurus_lookups++;
+		if(thesaurus)
+			m_stats.thesaurus_hits++;
+#endif
+		return thesaurus;
 	}
 	return NULL;
 }
 
-Segmenter::Segmenter():m_tagger(NULL) 
+Segmenter::Segmenter():m_tagger(NULL), m_stats_sink(NULL)
 {
+	m_thunk.m_stats = &m_stats;
 	m_symdict = NULL;
 	m_kwdict = NULL;
 	m_weightdict = NULL;
 	m_config = NULL;
 	m_thesaurus = NULL;
+	m_normalizer = NULL;
+	m_buffer_tags = NULL;
+	m_kernel = &Segmenter::peekKernel<KERNEL_ALL>;
 	//if(!m_lower)
 	//	m_lower = ToLower::Get();
 }
@@ -70,17 +107,68 @@ Segmenter::~Segmenter()
 */
 int Segmenter::toLowerCpy(const u1* src, u1* det, u2 det_size)
 {
+	u1 buf[4];
+	u2 len = 0;
+	if(!det_size)
+		return 1;
+	u1* end = det + det_size - 1; //leave room for NUL
+	while(*src) {
+		int iCode = csrUTF8Decode(src, len);
+		const u1* chr = src;
+		u2 nlen = 1;
+		if(iCode > 0) {
+			nlen = len;
+			int iLower = CharNormalizer::foldCase(iCode);
+			if(iLower != iCode && csrUTF8Encode(buf, iLower) <= len) {
+				nlen = (u2)csrUTF8Encode(buf, iLower);
+				chr = buf;
+			}
+		}else
+			len = 1;
+		if(det + nlen > end) {
+			*det = 0;
+			return 1;
+		}
+		memcpy(det, chr, nlen);
+		det += nlen;
+		src += len;
+	}
+	*det = 0;
 	return 0;
 }
-void Segmenter::setBuffer(u1* buf, u4 length)
+void Segmenter::flushStats()
+{
+#if MMSEG_STATS
+	if(m_stats_sink)
+		m_stats_sink->add(m_stats);
+	m_stats.reset();
+#endif
+}
+
+void Segmenter::setBuffer(u1* buf, u4 length, const u1* tags)
 {
+	resetBuffer(buf, length, tags, 1, 1);
+}
+void Segmenter::resetBuffer(u1* buf, u4 length, const u1* tags, u1 bFlush, u1 bTrace)
+{
+#if MMSEG_STATS
+	if(bFlush && (m_stats.bytes || m_stats.chunks))
+		flushStats();
+#endif
 	m_buffer_begin = buf;
 	m_buffer_ptr = m_buffer_begin;
 	m_buffer_end = &buf[length];
+	m_buffer_tags = tags;
 	m_buffer_chunk_begin = m_buffer_begin;
+	m_buffer_chunk_end = m_buffer_begin;
+	m_char_offset = 0;
+	m_norm.clear();
+	m_decoder.clear();
 	if(!m_tagger)
 		m_tagger = ChineseCharTagger::Get();
+	//clears only the lattice positions the last text set.
 	m_thunk.reset();
+	m_thunk.m_trace = bTrace ? SegmentTrace::begin(length) : NULL;
 	return;
 }
 
@@ -91,6 +179,46 @@ u1  Segmenter::isSentenceEnd()
 	return (aLen==0);
 }
 
+u4 Segmenter::segmentOffsets(u1* buf, u4 length, std::vector<u4>& offsets)
+{
+	u4 count = 0;
+	setBuffer(buf, length);
+	while(1) {
+		u2 len = 0, symlen = 0;
+		const u1* tok = peekToken(len, symlen);
+		if(!tok || !*tok || !len)
+			break;
+		u4 start = (u4)(m_buffer_ptr - buf);
+		popToken(len);
+		offsets.push_back(start);
+		offsets.push_back(start + len);
+		count++;
+	}
+	flushStats();
+	return count;
+}
+
+u4 Segmenter::segmentQuery(u1* buf, u4 length, u4* offsets, u4 max_tokens)
+{
+	if(length > QUERY_MAX_LENGTH)
+		setBuffer(buf, length);
+	else
+		resetBuffer(buf, length, NULL, 0, 0);
+	u4 count = 0;
+	while(count < max_tokens) {
+		u2 len = 0, symlen = 0;
+		const u1* tok = (this->*m_kernel)(len, symlen);
+		if(!tok || !*tok || !len)
+			break;
+		u4 start = (u4)(m_buffer_ptr - buf);
+		popToken(len);
+		offsets[count*2] = start;
+		offsets[count*2+1] = start + len;
+		count++;
+	}
+	return count;
+}
+
 int Segmenter::isKeyWord(u1* buf, u4 length)
 {
 	if(!m_kwdict) return 0;
@@ -101,7 +229,7 @@ int Segmenter::isKeyWord(u1* buf, u4 length)
 int Segmenter::getWordWeight(u1* buf, u4 length)
 {
 	if(!m_weightdict) return length; //use token length as weight
-	int count =  m_weightdict->exactMatch((const char*)buf);
+	int count =  m_weightdict->exactMatch((const char*)buf, length, NULL);
 	if(count > 100)
 		return 100;
 	if(count < 1) //might be 0 or neg, reset to default.
@@ -109,18 +237,61 @@ int Segmenter::getWordWeight(u1* buf, u4 length)
 	return count;
 }
 
-//ungly hacking
-int dry_strchr(const u1* pattern, u2 iCode)
+//hit lengths in the normalized text back to the window, a hit ends inside a char is dropped.
+static int window_hits(NormalizedText& norm, u4 pos, UnigramDict::result_pair_type* rs, int num)
+{
+	int n = 0;
+	for(int k = 0; k < num; k++) {
+		u2 len = norm.origLength(pos, (u4)rs[k].length);
+		if(!len)
+			continue;
+		rs[n] = rs[k];
+		rs[n].length = len;
+		n++;
+	}
+	return n;
+}
+
+/*
+Add the raw hits to the normalized ones in rs, both ascending by length: a dictionary word
+not in normalized form, e.g. with a full-width letter, is only found by the raw text.
+@return hits in rs, one of each length
+*/
+static int merge_hits(UnigramDict::result_pair_type* rs, int num, const UnigramDict::result_pair_type* raw, int nraw)
+{
+	int i = num - 1, j = nraw - 1, k = num + nraw - 1;
+	while(j >= 0) {
+		if(i >= 0 && rs[i].length >= raw[j].length)
+			rs[k--] = rs[i--];
+		else
+			rs[k--] = raw[j--];
+	}
+	//the raw hit goes first of the same length, it is the word itself.
+	int n = 0;
+	for(k = 0; k < num + nraw; k++) {
+		if(n && rs[n-1].length == rs[k].length)
+			continue;
+		rs[n++] = rs[k];
+	}
+	return n;
+}
+
+void Segmenter_ConfigObj::compileJoint()
 {
-	const u1* ptr = pattern;
-	while(*ptr){
-		if(*ptr == iCode)
-			return ptr-pattern;
-		ptr++;
+	memset(joint_map, 0, sizeof(joint_map));
+	const u1* ptr = number_and_ascii_joint;
+	while(*ptr) {
+		u2 len = 0;
+		int iCode = csrUTF8Decode(ptr, len);
+		if(iCode <= 0 || !len) {
+			//not UTF-8, the byte itself as before.
+			iCode = *ptr;
+			len = 1;
+		}
+		if(iCode < 0x10000)
+			joint_map[iCode >> 3] |= (u1)(1 << (iCode & 7));
+		ptr += len;
 	}
-	if(!*ptr)
-		return -1;
-	return -1;
 }
 
 const u1* Segmenter::popOmniToken(u2& aLen)
@@ -132,28 +303,121 @@ const u1* Segmenter::popOmniToken(u2& aLen)
 	*/
 	// m_buffer_ptr - m_buffer_begin; //the current offset.
 	u4 iOffset = m_thunk.popOmniToken((m_buffer_ptr - m_buffer_chunk_begin), aLen);
+	if(!aLen && nextOmniWindow())
+		iOffset = m_thunk.popOmniToken((m_buffer_ptr - m_buffer_chunk_begin), aLen);
 	if(aLen)
 		return &m_buffer_chunk_begin[iOffset];
 	return NULL;
 }
 
+u4 Segmenter::popOmniTokens(OmniItem* items, u4 max_items)
+{
+	u4 count = 0;
+	while(1) {
+		u4 iChunkOffset = (u4)(m_buffer_chunk_begin - m_buffer_begin);
+		u4 num = m_thunk.popOmniTokens((m_buffer_ptr - m_buffer_chunk_begin), &items[count], max_items - count);
+		for(u4 i = count; i < count + num; i++)
+			items[i].offset += iChunkOffset;
+		count += num;
+		if(count == max_items || !nextOmniWindow())
+			break;
+	}
+	return count;
+}
+
+/*
+The omni tokens at the current position are checked against the main token there. At the end
+of a window filled up, that token is decided by the next window, start it now.
+@return 1, a window is started.
+*/
+u1 Segmenter::nextOmniWindow()
+{
+	if(m_thunk.length() || !m_thunk.hasTail())
+		return 0;
+	u2 len = 0, symlen = 0;
+	peekToken(len, symlen);
+	return 1;
+}
+
+void Segmenter::selectKernel()
+{
+	static const PeekKernel kernels[KERNEL_ALL + 1] = {
+		&Segmenter::peekKernel<0>, &Segmenter::peekKernel<1>,
+		&Segmenter::peekKernel<2>, &Segmenter::peekKernel<3>,
+		&Segmenter::peekKernel<4>, &Segmenter::peekKernel<5>,
+		&Segmenter::peekKernel<6>, &Segmenter::peekKernel<7>,
+		&Segmenter::peekKernel<8>, &Segmenter::peekKernel<9>,
+		&Segmenter::peekKernel<10>, &Segmenter::peekKernel<11>,
+		&Segmenter::peekKernel<12>, &Segmenter::peekKernel<13>,
+		&Segmenter::peekKernel<14>, &Segmenter::peekKernel<15>
+	};
+	int flags = 0;
+	if(m_kwdict)
+		flags |= KERNEL_KW;
+	if(m_symdict && m_symdict->isLoad())
+		flags |= KERNEL_SYNONYM;
+	if(m_config && m_normalizer && m_config->normalize)
+		flags |= KERNEL_NORMALIZE;
+	if(m_config && (m_config->merge_number_and_ascii || m_config->seperate_number_ascii
+		|| m_config->number_and_ascii_joint[0]))
+		flags |= KERNEL_NUMBER_RULES;
+	m_kernel = kernels[flags];
+}
+
 const u1* Segmenter::peekToken(u2& aLen, u2& aSymLen, u2 n)
+{
+	if( n == 1)
+		return peekKwToken(aLen, aSymLen);
+	return (this->*m_kernel)(aLen, aSymLen);
+}
+
+//peekToken, with the features out of FLAGS compiled away.
+template <int FLAGS>
+const u1* Segmenter::peekKernel(u2& aLen, u2& aSymLen)
 {
 	//check is sep char
 	//skip \r
 	//reset unigram when \n
 	//reset unigram when 
 	//get token
-	if( n == 1)
-		return peekKwToken(aLen, aSymLen);
 	u2 len;
   	u1* tok = m_thunk.peekToken(aLen);
+	if(aLen && !(FLAGS & KERNEL_SYNONYM)) {
+		aSymLen = aLen;
+		return m_buffer_ptr;
+	}
 	if(aLen){
 		tok = m_buffer_ptr;
 		//m_buffer_ptr += aLen;
 		//check sym
 		int sym_key_len = 64;
-		const char* sym = m_symdict->maxMatch((const char*)tok, sym_key_len);
+		const char* key = (const char*)tok;
+		u4 pos = (u4)(m_buffer_ptr - m_buffer_chunk_begin);
+		if((FLAGS & KERNEL_NORMALIZE) && m_norm.base() == m_buffer_chunk_begin) {
+			const u1* nkey = m_norm.at(pos, sym_key_len);
+			if(nkey)
+				key = (const char*)nkey;
+		}
+		const char* sym = m_symdict->maxMatch(key, sym_key_len);
+		if(sym && key != (const char*)tok) {
+			sym_key_len = m_norm.origLength(pos, sym_key_len);
+			if(!sym_key_len)
+				sym = NULL;
+		}
+		if(key != (const char*)tok && m_norm.changedFrom(pos)) {
+			//a key not in normalized form, take the longer match.
+			int raw_key_len = 64;
+			const char* raw_sym = m_symdict->maxMatch((const char*)tok, raw_key_len);
+			if(raw_sym && (!sym || raw_key_len > sym_key_len)) {
+				sym = raw_sym;
+				sym_key_len = raw_key_len;
+			}
+		}
+#if MMSEG_STATS
+		m_stats.synonym_lookups++;
+		if(sym)
+			m_stats.synonym_hits++;
+#endif
 		if(sym){
 			aSymLen = (u2)strlen(sym);
 			aLen = sym_key_len;
@@ -172,24 +436,63 @@ const u1* Segmenter::peekToken(u2& aLen, u2& aSymLen, u2 n)
 		return tok;
 	}
 	
-	m_thunk.reset();
-	m_buffer_chunk_begin = m_buffer_ptr;
-
 	u1* ptr = m_buffer_ptr;
 	int i = 0;
+	if(m_thunk.hasTail() && m_buffer_ptr < m_buffer_chunk_end) {
+		//the last window was filled up, go on from its undecided positions.
+		m_thunk.slide((u2)(m_buffer_ptr - m_buffer_chunk_begin));
+		ptr = m_buffer_chunk_end;
+		i = (int)(m_buffer_chunk_end - m_buffer_ptr);
+	}else
+		m_thunk.reset();
+	m_buffer_chunk_begin = m_buffer_ptr;
+	//dictionary lookups see the normalized text, positions stay in the buffer.
+	u1 iNormalize = (FLAGS & KERNEL_NORMALIZE) ? m_config->normalize : 0;
+	UnigramDict* kwdict = (FLAGS & KERNEL_KW) ? m_kwdict : NULL;
+	if(iNormalize)
+		m_norm.reset(m_buffer_chunk_begin, m_buffer_end, m_normalizer, iNormalize);
+	else
+		m_norm.clear();
+
+	u1 bCarry = 1; //positions match the bytes, the tail can be carried.
 	u2 tag  = 0;
 	int iCode = 0;
+	//chars are decoded and tagged a block a time, the last window might have done some.
+	m_decoder.init(m_tagger, m_normalizer, iNormalize);
+	u4 nChars = m_decoder.count();
+	u4 iChar = m_decoder.find(ptr);
+#if MMSEG_STATS
+	//reading the clock costs as much as a short chunk, time 1 of each MMSEG_STATS_SAMPLE chunks.
+	u1 bTimed = (m_stats.chunks % MMSEG_STATS_SAMPLE) == 0;
+	u8 t_begin = bTimed ? SegmentStats::now_ns() : 0;
+#endif
 	while(*ptr && (ptr<m_buffer_end) && i<CHUNK_BUFFER_SIZE){
 		UnigramDict::result_pair_type rs[1024];
 		//try to tag
-		iCode = csrUTF8Decode(ptr, len);
+		if(iChar == nChars) {
+			nChars = m_decoder.decode(ptr, m_buffer_end, m_buffer_tags ? &m_buffer_tags[ptr - m_buffer_begin] : NULL);
+			iChar = 0;
+		}
+		iCode = m_decoder.m_code[iChar];
+		len = m_decoder.m_length[iChar];
+		tag = m_decoder.m_tag[iChar];
+		iChar++;
 		if(iCode == 0xFEFF) {
 			ptr += len;
 			m_thunk.pushToken(len, 0);
 			m_buffer_chunk_begin = ptr; //sepcial deal with win32 file header.
-			m_buffer_begin = ptr; //skip win32 head.
+			bCarry = 0;
+			if(iNormalize)
+				m_norm.reset(m_buffer_chunk_begin, m_buffer_end, m_normalizer, iNormalize);
 
-			iCode = csrUTF8Decode(ptr, len);
+			if(iChar == nChars) {
+				nChars = m_decoder.decode(ptr, m_buffer_end, m_buffer_tags ? &m_buffer_tags[ptr - m_buffer_begin] : NULL);
+				iChar = 0;
+			}
+			iCode = m_decoder.m_code[iChar];
+			len = m_decoder.m_length[iChar];
+			tag = m_decoder.m_tag[iChar];
+			iChar++;
 		}
 		if(iCode == 0){
 			//unexpected end
@@ -200,17 +503,43 @@ const u1* Segmenter::peekToken(u2& aLen, u2& aSymLen, u2 n)
 			//wrong utf80encode
 			m_thunk.pushToken(1,0);
 			ptr++;
+			bCarry = 0;
 			continue;
 		}
 		if(iCode == '\r'||iCode == '\n'){
 			break;
 		}
-		tag = m_tagger->tagUnicode(iCode,1);
-		tag = (tag&0x3F) + 'a' -1;
+#if MMSEG_STATS
+		m_stats.chars++;
+#endif
 		if(tag == 'w' || tag == 'm' || tag == 'e')
 			break;
+		const char* key = (const char*)ptr;
+		//i is behind the bytes after a wrong byte, the normalized text goes by bytes.
+		u4 pos = (u4)(ptr - m_buffer_chunk_begin);
+		if(iNormalize) {
+			const u1* nkey = m_norm.at(pos, MAX_TOKEN_LENGTH);
+			if(nkey)
+				key = (const char*)nkey;
+		}
 		//check tagger
-		int num = m_unidict->findHits((const char*)ptr,&rs[1],1024-1, MAX_TOKEN_LENGTH);
+		int num = m_unidict->findHits(key,&rs[1],1024-1, MAX_TOKEN_LENGTH);
+#if MMSEG_STATS
+		m_stats.find_hits++;
+		m_stats.hits += num;
+#endif
+		u1 bRaw = key != (const char*)ptr && m_norm.changedFrom(pos);
+		if(num && key != (const char*)ptr)
+			num = window_hits(m_norm, pos, &rs[1], num);
+		if(bRaw) {
+			UnigramDict::result_pair_type raw[MAX_TOKEN_LENGTH];
+			int nraw = m_unidict->findHits((const char*)ptr, raw, MAX_TOKEN_LENGTH, MAX_TOKEN_LENGTH);
+#if MMSEG_STATS
+			m_stats.find_hits++;
+			m_stats.hits += nraw;
+#endif
+			num = merge_hits(&rs[1], num, raw, nraw);
+		}
 		if(num){
 			if(rs[1].length == len)
 				m_thunk.setItems(i, num, &rs[1], m_unidict);
@@ -225,17 +554,56 @@ const u1* Segmenter::peekToken(u2& aLen, u2& aSymLen, u2 n)
 			rs[0].value = 1;
 			m_thunk.setItems(i,1, rs, m_unidict);
 		}
-		if(m_kwdict)
-			num = m_kwdict->findHits((const char*)ptr,&rs[1],1024-1, MAX_TOKEN_LENGTH);
-		else
+		if(kwdict) {
+			num = kwdict->findHits(key,&rs[1],1024-1, MAX_TOKEN_LENGTH);
+#if MMSEG_STATS
+			m_stats.find_hits++;
+			m_stats.hits += num;
+#endif
+			if(num && key != (const char*)ptr)
+				num = window_hits(m_norm, pos, &rs[1], num);
+			if(bRaw) {
+				UnigramDict::result_pair_type raw[MAX_TOKEN_LENGTH];
+				int nraw = kwdict->findHits((const char*)ptr, raw, MAX_TOKEN_LENGTH, MAX_TOKEN_LENGTH);
+#if MMSEG_STATS
+				m_stats.find_hits++;
+				m_stats.hits += nraw;
+#endif
+				num = merge_hits(&rs[1], num, raw, nraw);
+			}
+		}else
 			num = 0;
-		m_thunk.setKwItems(i, num, &rs[1], m_kwdict); //set to kword
+		m_thunk.setKwItems(i, num, &rs[1], kwdict); //set to kword
 
 		ptr +=  len;
 		i+=len;
 	}
 	//do real segment
-	m_thunk.Tokenize(m_config->omni_segmentation);
+#if MMSEG_STATS
+	u8 t_lookup = 0;
+	if(bTimed) {
+		t_lookup = SegmentStats::now_ns();
+		m_stats.lookup_ns += (t_lookup - t_begin) * MMSEG_STATS_SAMPLE;
+	}
+#endif
+	m_buffer_chunk_end = ptr;
+	//the text goes on beyond the window, leave the positions near the end to the next one.
+	i4 decide_end = -1;
+	if(bCarry && i >= CHUNK_BUFFER_SIZE && ptr < m_buffer_end && *ptr)
+		decide_end = i - len - CHUNK_LOOKAHEAD;
+	if(m_thunk.m_trace) {
+		TraceRecord* rec = m_thunk.m_trace->next();
+		rec->type = TraceRecord::CHUNK;
+		rec->count = 0;
+		rec->pos = (u2)i;
+		rec->value = (u4)(m_buffer_chunk_begin - m_buffer_begin);
+		m_thunk.m_trace->commit(rec);
+	}
+	m_thunk.Tokenize(m_config->omni_segmentation, decide_end);
+#if MMSEG_STATS
+	if(bTimed)
+		m_stats.tokenize_ns += (SegmentStats::now_ns() - t_lookup) * MMSEG_STATS_SAMPLE;
+#endif
 	if(iCode == '\r'||iCode == '\n'){
 		ptr += 1;
 		m_thunk.pushToken(1,0);
@@ -246,44 +614,57 @@ const u1* Segmenter::peekToken(u2& aLen, u2& aSymLen, u2 n)
 		ptr += len;
 		u2 prev_tag = tag;
 		int iCodep = iCode;
+		const Segmenter_ConfigObj* config = (FLAGS & KERNEL_NUMBER_RULES) ? m_config : NULL;
+		u1 bSeperate = config && config->seperate_number_ascii;
+		u1 bMerge = config && config->merge_number_and_ascii;
+		u1 bJointp = config && config->isJoint(iCodep);
 		while(*ptr){
-			int iCoden = csrUTF8Decode(ptr, len);
-			tag = m_tagger->tagUnicode(iCoden,1);
-			tag = (tag&0x3F) + 'a' -1;
+			if(iChar == nChars) {
+				nChars = m_decoder.decode(ptr, m_buffer_end, m_buffer_tags ? &m_buffer_tags[ptr - m_buffer_begin] : NULL);
+				iChar = 0;
+			}
+			int iCoden = m_decoder.m_code[iChar];
+			if(iCoden > 0) {
+				len = m_decoder.m_length[iChar];
+				tag = m_decoder.m_tag[iChar];
+				iChar++;
+			}else{
+				//csrUTF8Decode keeps the last length for a wrong byte, go its way; the block is out of step then.
+				iCoden = csrUTF8Decode(ptr, len);
+				if(iNormalize)
+					iCoden = m_normalizer->map(iCoden, iNormalize);
+				tag = m_tagger->tagUnicode(iCoden,1);
+				tag = (tag&0x3F) + 'a' -1;
+				iChar = nChars = 0;
+			}
+#if MMSEG_STATS
+			m_stats.chars++;
+#endif
 			/*
 				- if seperate_number_ascii
 			*/
-			if((tag == 'm') && m_config && m_config->seperate_number_ascii) 
+			if((tag == 'm') && bSeperate) 
 				break;
-			//if(tag != prev_tag)
+			u1 bJoint = config && config->isJoint(iCoden);
 			/*
 				here  needs to check more rules.
 				- if merge_number_and_ascii=true, and tag = m, prev_tag = e, or reserve, do NOT break;
-				- if iCoden in number_and_ascii_joint no NOT break;
-				- if iCode in .... NOT break;
+				- if iCoden or the char before in number_and_ascii_joint no NOT break;
 				- if seperate_number_ascii = true, break all rules above.
 			*/
 			if(tag != prev_tag) {
-				u1 bContinue = 0;
-				if(m_config && m_config->merge_number_and_ascii &&
+				if(bSeperate)
+					break;
+				u1 bContinue = bMerge &&
 					((tag == 'e' && prev_tag == 'm') ||
-					 (tag == 'm' && prev_tag == 'e'))
-					 )
-					 bContinue = 1;
-				if(m_config && !bContinue)
-					bContinue = (-1 != dry_strchr(m_config->number_and_ascii_joint,iCoden));
-				if(m_config && !bContinue)
-					bContinue = (-1 != dry_strchr(m_config->number_and_ascii_joint,iCodep));
-				
-				if(m_config && m_config->seperate_number_ascii)
-					bContinue = 0;
-				
-				if(!bContinue)
+					 (tag == 'm' && prev_tag == 'e'));
+				if(!bContinue && !bJoint && !bJointp)
 					break;
 			}
 			ptr +=  len;
 			tok_len += len;
 			iCodep = iCoden;
+			bJointp = bJoint;
 		}
 		//push tok_len.
 		//m or e have no must have.
@@ -294,7 +675,7 @@ const u1* Segmenter::peekToken(u2& aLen, u2& aSymLen, u2 n)
 		m_thunk.pushToken(len,-1);
 	}
 	if(m_thunk.length())
-		return peekToken(aLen,aSymLen);
+		return peekKernel<FLAGS>(aLen,aSymLen);
 	/*
 	tok = m_thunk.peekToken(len);
 	//set charpos
@@ -321,6 +702,10 @@ void Segmenter::popToken(u2 len, u2 n)
 	*/
 	if(n==1)
 		return popKwToken(len);
+#if MMSEG_STATS
+	m_stats.tokens++;
+	m_stats.bytes += len;
+#endif
     u2 tLen = m_thunk.popupToken();
 	u2 diff = 0;
 	while(1) {
@@ -334,9 +719,11 @@ void Segmenter::popToken(u2 len, u2 n)
 	}
 	// m_thunk have data & tLen NOT eat up all words.
 	if (m_thunk.length() && tLen != len){
+		m_char_offset += utf16_units(m_buffer_ptr, m_buffer_ptr + tLen - diff);
 		m_buffer_ptr += tLen - diff;
 		return;
 	}
+	m_char_offset += utf16_units(m_buffer_ptr, m_buffer_ptr + len);
 	m_buffer_ptr += len;
 }
 
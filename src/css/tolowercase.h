@@ -1,5 +1,46 @@
-//0x0 0x100
-const static u2 table_0[] = {
+//generated by script/build_tolower_table.py, do NOT edit.
+
+//page of each high byte in lower_pages
+const static u1 lower_page_index[256] = {
+1,2,3,4,5,6,7,0,0,8,9,10,0,0,0,0,
+11,0,0,0,0,0,12,0,0,0,0,0,0,13,14,15,
+16,17,0,0,0,0,0,0,0,0,0,0,18,0,0,19,
+20,21,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,22,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+0,0,0,0,0,0,0,0,0,23,24,25,0,0,0,26,
+};
+
+//lower case of each low byte, 0 is the char itself
+const static u2 lower_pages[][256] = {
+{
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -15,12 +56,9 @@ const static u2 table_0[] = {
 0x61,0x61,0x61,0x61,0xe4,0xe5,0xe6,0x63,0x65,0x65,0x65,0x65,0x69,0x69,0x69,0x69,
 0x0,0x6e,0x6f,0x6f,0x6f,0x6f,0xf6,0x0,0x6f,0x75,0x75,0x75,0xfc,0x79,0x0,0x73,
 0x61,0x61,0x61,0x61,0x61,0x61,0x0,0x63,0x65,0x65,0x65,0x65,0x69,0x69,0x69,0x69,
-0x0,0x6e,0x6f,0x6f,0x6f,0x6f,0x6f,0x0,0x6f,0x75,0x75,0x75,0x75,0x79,0x0,0x79
-};
-/*
-A>a B>b C>c D>d E>e F>f G>g H>h I>i J>j K>k L>l M>m N>n O>o P>p Q>q R>r S>s T>t U>u V>v W>w X>x Y>y Z>z À>a Á>a Â>a Ã>a Ä>ä Å>å Æ>æ Ç>c È>e É>e Ê>e Ë>e Ì>i Í>i Î>i Ï>i Ñ>n Ò>o Ó>o Ô>o Õ>o Ö>ö Ø>o Ù>u Ú>u Û>u Ü>ü Ý>y ß>s à>a á>a â>a ã>a ä>a å>a ç>c è>e é>e ê>e ë>e ì>i í>i î>i ï>i ñ>n ò>o ó>o ô>o õ>o ö>o ø>o ù>u ú>u û>u ü>u ý>y ÿ>y */
-//0x1 0x200
-const static u2 table_1[] = {
+0x0,0x6e,0x6f,0x6f,0x6f,0x6f,0x6f,0x0,0x6f,0x75,0x75,0x75,0x75,0x79,0x0,0x79,
+},
+{
 0x61,0x61,0x61,0x61,0x105,0x61,0x107,0x63,0x63,0x63,0x63,0x63,0x63,0x63,0x64,0x64,
 0x64,0x64,0x65,0x65,0x65,0x65,0x65,0x65,0x119,0x65,0x65,0x65,0x67,0x67,0x67,0x67,
 0x67,0x67,0x67,0x67,0x68,0x68,0x68,0x68,0x69,0x69,0x69,0x69,0x69,0x69,0x69,0x69,
@@ -36,12 +74,9 @@ const static u2 table_1[] = {
 0x0,0x0,0x0,0x0,0x0,0x64,0x0,0x0,0x6c,0x0,0x0,0x6e,0x0,0x61,0x61,0x69,
 0x69,0x6f,0x6f,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x65,0x61,0x61,
 0x61,0x61,0xe6,0xe6,0x67,0x67,0x67,0x67,0x6b,0x6b,0x6f,0x6f,0x6f,0x6f,0x0,0x0,
-0x6a,0x0,0x64,0x0,0x67,0x67,0x0,0x0,0x6e,0x6e,0x61,0x61,0xe6,0xe6,0x6f,0x6f
-};
-/*
-Ā>a ā>a Ă>a ă>a Ą>ą ą>a Ć>ć ć>c Ĉ>c ĉ>c Ċ>c ċ>c Č>c č>c Ď>d ď>d Đ>d đ>d Ē>e ē>e Ĕ>e ĕ>e Ė>e ė>e Ę>ę ę>e Ě>e ě>e Ĝ>g ĝ>g Ğ>g ğ>g Ġ>g ġ>g Ģ>g ģ>g Ĥ>h ĥ>h Ħ>h ħ>h Ĩ>i ĩ>i Ī>i ī>i Ĭ>i ĭ>i Į>i į>i İ>i ı>i Ĵ>j ĵ>j Ķ>k ķ>k Ĺ>l ĺ>l Ļ>l ļ>l Ľ>l ľ>l Ŀ>l ŀ>l Ł>ł ł>l Ń>ń ń>n Ņ>n ņ>n Ň>n ň>n ŉ>n Ō>o ō>o Ŏ>o ŏ>o Ő>o ő>o Ŕ>r ŕ>r Ŗ>r ŗ>r Ř>r ř>r Ś>ś ś>s Ŝ>s ŝ>s Ş>s ş>s Š>s š>s Ţ>t ţ>t Ť>t ť>t Ŧ>t ŧ>t Ũ>u ũ>u Ū>u ū>u Ŭ>u ŭ>u Ů>u ů>u Ű>u ű>u Ų>u ų>u Ŵ>w ŵ>w Ŷ>y ŷ>y Ÿ>y Ź>ź ź>z Ż>ż ż>z Ž>z ž>z ſ>s ƀ>b Ɓ>b Ƃ>b ƃ>b Ɔ>o Ƈ>c ƈ>c Ɖ>d Ɗ>d Ƌ>d ƌ>d Ǝ>e Ɛ>e Ƒ>f ƒ>f Ɠ>g Ɨ>i Ƙ>k ƙ>k ƚ>l Ɯ>m Ɲ>n ƞ>n Ɵ>o Ơ>o ơ>o Ƥ>p ƥ>p ƫ>t Ƭ>t ƭ>t Ʈ>t Ư>u ư>u Ʋ>v Ƴ>y ƴ>y Ƶ>z ƶ>z ǅ>d ǈ>l ǋ>n Ǎ>a ǎ>a Ǐ>i ǐ>i Ǒ>o ǒ>o Ǔ>u ǔ>u Ǖ>u ǖ>u Ǘ>u ǘ>u Ǚ>u ǚ>u Ǜ>u ǜ>u ǝ>e Ǟ>a ǟ>a Ǡ>a ǡ>a Ǣ>æ ǣ>æ Ǥ>g ǥ>g Ǧ>g ǧ>g Ǩ>k ǩ>k Ǫ>o ǫ>o Ǭ>o ǭ>o ǰ>j ǲ>d Ǵ>g ǵ>g Ǹ>n ǹ>n Ǻ>a ǻ>a Ǽ>æ ǽ>æ Ǿ>o ǿ>o */
-//0x2 0x300
-const static u2 table_2[] = {
+0x6a,0x0,0x64,0x0,0x67,0x67,0x0,0x0,0x6e,0x6e,0x61,0x61,0xe6,0xe6,0x6f,0x6f,
+},
+{
 0x61,0x61,0x61,0x61,0x65,0x65,0x65,0x65,0x69,0x69,0x69,0x69,0x6f,0x6f,0x6f,0x6f,
 0x72,0x72,0x72,0x72,0x75,0x75,0x75,0x75,0x73,0x73,0x74,0x74,0x0,0x0,0x68,0x68,
 0x6e,0x64,0x0,0x0,0x7a,0x7a,0x61,0x61,0x65,0x65,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,
@@ -57,12 +92,9 @@ const static u2 table_2[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x6c,0x73,0x78,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-Ȁ>a ȁ>a Ȃ>a ȃ>a Ȅ>e ȅ>e Ȇ>e ȇ>e Ȉ>i ȉ>i Ȋ>i ȋ>i Ȍ>o ȍ>o Ȏ>o ȏ>o Ȑ>r ȑ>r Ȓ>r ȓ>r Ȕ>u ȕ>u Ȗ>u ȗ>u Ș>s ș>s Ț>t ț>t Ȟ>h ȟ>h Ƞ>n ȡ>d Ȥ>z ȥ>z Ȧ>a ȧ>a Ȩ>e ȩ>e Ȫ>o ȫ>o Ȭ>o ȭ>o Ȯ>o ȯ>o Ȱ>o ȱ>o Ȳ>y ȳ>y ȴ>l ȵ>n ȶ>t ȷ>j Ⱥ>a Ȼ>c ȼ>c Ƚ>l Ⱦ>t ȿ>s ɀ>z Ƀ>b Ʉ>u Ʌ>v Ɇ>e ɇ>e Ɉ>j ɉ>j Ɋ>q ɋ>q Ɍ>r ɍ>r Ɏ>y ɏ>y ɐ>a ɓ>b ɔ>o ɕ>c ɖ>d ɗ>d ɘ>e ɛ>e ɜ>e ɝ>e ɞ>e ɟ>j ɠ>g ɡ>g ɢ>g ɥ>h ɦ>h ɨ>i ɪ>i ɫ>l ɬ>l ɭ>l ɯ>m ɰ>m ɱ>m ɲ>n ɳ>n ɴ>n ɵ>o ɹ>r ɺ>r ɻ>r ɼ>r ɽ>r ɾ>r ɿ>r ʀ>r ʁ>r ʂ>s ʄ>j ʇ>t ʈ>t ʉ>u ʋ>v ʌ>v ʍ>w ʎ>y ʏ>y ʐ>z ʑ>z ʗ>c ʙ>b ʚ>e ʛ>g ʜ>h ʝ>j ʞ>k ʟ>l ʠ>q ʮ>h ʯ>h ʰ>h ʱ>h ʲ>j ʳ>r ʴ>r ʵ>r ʶ>r ʷ>w ʸ>y ˡ>l ˢ>s ˣ>x */
-//0x3 0x400
-const static u2 table_3[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -78,12 +110,9 @@ const static u2 table_3[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x3b9,0x3c5,0x3bf,0x3c5,0x3c9,0x0,
 0x3b2,0x3b8,0x3c5,0x3c5,0x3c5,0x3c6,0x3c0,0x0,0x3d9,0x0,0x3db,0x0,0x3dd,0x0,0x3df,0x0,
 0x3e1,0x0,0x3e3,0x0,0x3e5,0x0,0x3e7,0x0,0x3e9,0x0,0x3eb,0x0,0x3ed,0x0,0x3ef,0x0,
-0x3ba,0x3c1,0x3c3,0x0,0x3b8,0x3b5,0x3b5,0x3f8,0x0,0x3c3,0x3fb,0x0,0x0,0x0,0x0,0x0
-};
-/*
-Ά>α Έ>ε Ή>η Ί>ι Ό>ο Ύ>υ Ώ>ω ΐ>ι Α>α Β>β Γ>γ Δ>δ Ε>ε Ζ>ζ Η>η Θ>θ Ι>ι Κ>κ Λ>λ Μ>μ Ν>ν Ξ>ξ Ο>ο Π>π Ρ>ρ Σ>σ Τ>τ Υ>υ Φ>φ Χ>χ Ψ>ψ Ω>ω Ϊ>ι Ϋ>υ ά>α έ>ε ή>η ί>ι ΰ>υ ϊ>ι ϋ>υ ό>ο ύ>υ ώ>ω ϐ>β ϑ>θ ϒ>υ ϓ>υ ϔ>υ ϕ>φ ϖ>π Ϙ>ϙ Ϛ>ϛ Ϝ>ϝ Ϟ>ϟ Ϡ>ϡ Ϣ>ϣ Ϥ>ϥ Ϧ>ϧ Ϩ>ϩ Ϫ>ϫ Ϭ>ϭ Ϯ>ϯ ϰ>κ ϱ>ρ ϲ>σ ϴ>θ ϵ>ε ϶>ε Ϸ>ϸ Ϲ>σ Ϻ>ϻ */
-//0x4 0x500
-const static u2 table_4[] = {
+0x3ba,0x3c1,0x3c3,0x0,0x3b8,0x3b5,0x3b5,0x3f8,0x0,0x3c3,0x3fb,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x435,0x435,0x452,0x433,0x454,0x455,0x456,0x456,0x458,0x459,0x45a,0x45b,0x43a,0x438,0x443,0x45f,
 0x430,0x431,0x432,0x433,0x434,0x435,0x436,0x437,0x438,0x438,0x43a,0x43b,0x43c,0x43d,0x43e,0x43f,
 0x440,0x441,0x442,0x443,0x444,0x445,0x446,0x447,0x448,0x449,0x44a,0x44b,0x44c,0x44d,0x44e,0x44f,
@@ -99,12 +128,9 @@ const static u2 table_4[] = {
 0x4cf,0x436,0x436,0x43a,0x43a,0x43b,0x43b,0x43d,0x43d,0x43d,0x43d,0x447,0x447,0x43c,0x43c,0x0,
 0x430,0x430,0x430,0x430,0xe6,0xe6,0x435,0x435,0x4d9,0x0,0x4d9,0x4d9,0x436,0x436,0x437,0x437,
 0x4e1,0x0,0x438,0x438,0x438,0x438,0x43e,0x43e,0x43e,0x43e,0x43e,0x43e,0x44d,0x44d,0x443,0x443,
-0x443,0x443,0x443,0x443,0x447,0x447,0x433,0x433,0x44b,0x44b,0x433,0x433,0x445,0x445,0x445,0x445
-};
-/*
-Ѐ>е Ё>е Ђ>ђ Ѓ>г Є>є Ѕ>ѕ І>і Ї>і Ј>ј Љ>љ Њ>њ Ћ>ћ Ќ>к Ѝ>и Ў>у Џ>џ А>а Б>б В>в Г>г Д>д Е>е Ж>ж З>з И>и Й>и К>к Л>л М>м Н>н О>о П>п Р>р С>с Т>т У>у Ф>ф Х>х Ц>ц Ч>ч Ш>ш Щ>щ Ъ>ъ Ы>ы Ь>ь Э>э Ю>ю Я>я и>i й>i о>o ѐ>е ё>е ѓ>г і>i ї>і ќ>к ѝ>и ў>у Ѡ>ѡ Ѣ>ѣ Ѥ>ѥ Ѧ>ѧ Ѩ>ѩ Ѫ>ѫ Ѭ>ѭ Ѯ>ѯ Ѱ>ѱ Ѳ>ѳ Ѵ>ѵ Ѷ>ѵ ѷ>ѵ Ѹ>ѹ Ѻ>ѻ Ѽ>ѽ Ѿ>ѿ Ҁ>ҁ Ҋ>и ҋ>и Ҍ>ь ҍ>ь Ҏ>р ҏ>р Ґ>г ґ>г Ғ>г ғ>г Ҕ>г ҕ>г Җ>ж җ>ж Ҙ>з ҙ>з Қ>к қ>к Ҝ>к ҝ>к Ҟ>к ҟ>к Ҡ>к ҡ>к Ң>н ң>н Ҥ>н ҥ>н Ҧ>п ҧ>п Ҩ>ҩ Ҫ>с ҫ>с Ҭ>т ҭ>т Ү>у ү>у Ұ>у ұ>у Ҳ>х ҳ>х Ҵ>ҵ Ҷ>ч ҷ>ч Ҹ>ч ҹ>ч Һ>һ Ҽ>ҽ Ҿ>ҽ ҿ>ҽ Ӏ>ӏ Ӂ>ж ӂ>ж Ӄ>к ӄ>к Ӆ>л ӆ>л Ӈ>н ӈ>н Ӊ>н ӊ>н Ӌ>ч ӌ>ч Ӎ>м ӎ>м Ӑ>а ӑ>а Ӓ>а ӓ>а Ӕ>æ ӕ>æ Ӗ>е ӗ>е Ә>ә Ӛ>ә ӛ>ә Ӝ>ж ӝ>ж Ӟ>з ӟ>з Ӡ>ӡ Ӣ>и ӣ>и Ӥ>и ӥ>и Ӧ>о ӧ>о Ө>о ө>о Ӫ>о ӫ>о Ӭ>э ӭ>э Ӯ>у ӯ>у Ӱ>у ӱ>у Ӳ>у ӳ>у Ӵ>ч ӵ>ч Ӷ>г ӷ>г Ӹ>ы ӹ>ы Ӻ>г ӻ>г Ӽ>х ӽ>х Ӿ>х ӿ>х */
-//0x5 0x600
-const static u2 table_5[] = {
+0x443,0x443,0x443,0x443,0x447,0x447,0x433,0x433,0x44b,0x44b,0x433,0x433,0x445,0x445,0x445,0x445,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -120,12 +146,9 @@ const static u2 table_5[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-Ա>ա Բ>բ Գ>գ Դ>դ Ե>ե Զ>զ Է>է Ը>ը Թ>թ Ժ>ժ Ի>ի Լ>լ Խ>խ Ծ>ծ Կ>կ Հ>հ Ձ>ձ Ղ>ղ Ճ>ճ Մ>մ Յ>յ Ն>ն Շ>շ Ո>ո Չ>չ Պ>պ Ջ>ջ Ռ>ռ Ս>ս Վ>վ Տ>տ Ր>ր Ց>ց Ւ>ւ Փ>փ Ք>ք Օ>օ Ֆ>ֆ */
-//0x6 0x700
-const static u2 table_6[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x627,0x627,0x648,0x627,0x64a,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -141,12 +164,9 @@ const static u2 table_6[] = {
 0x6d5,0x0,0x6c1,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x6d2,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-آ>ا أ>ا ؤ>و إ>ا ئ>ي ۀ>ە ۂ>ہ ۓ>ے */
-//0x9 0xa00
-const static u2 table_9[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x928,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -162,12 +182,9 @@ const static u2 table_9[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x9a1,0x9a2,0x0,0x9af,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x9ac,0x9ac,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-????????????????????????????????*/
-//0xa 0xb00
-const static u2 table_10[] = {
+0x9ac,0x9ac,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -183,12 +200,9 @@ const static u2 table_10[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-????????????*/
-//0xb 0xc00
-const static u2 table_11[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -204,12 +218,9 @@ const static u2 table_11[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-??*/
-//0x10 0x1100
-const static u2 table_16[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -225,12 +236,9 @@ const static u2 table_16[] = {
 0x2d20,0x2d21,0x2d22,0x2d23,0x2d24,0x2d25,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x10dc,0x0,0x0,0x0
-};
-/*
-?ⴀ ??????????????????????????????????????????????????????????????Ⴠ>?????????????*/
-//0x16 0x1700
-const static u2 table_22[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x10dc,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -246,12 +254,9 @@ const static u2 table_22[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x62,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?b */
-//0x1d 0x1e00
-const static u2 table_29[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0xe6,0xe6,0x62,0x0,0x64,0x0,0x65,0x65,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,
 0x6f,0x6f,0x6f,0x6f,0x0,0x0,0x6f,0x6f,0x70,0x72,0x72,0x74,0x75,0x75,0x75,0x6d,
 0x76,0x77,0x7a,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x61,0xe6,0x62,0x62,
@@ -267,12 +272,9 @@ const static u2 table_29[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x72,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?æ ?æ ?b ?d ?e ?e ?i ?j ?k ?l ?m ?n ?o ?o ?o ?o ?o ?o ?o ?p ?r ?r ?t ?u ?u ?u ?m ?v ?w ?z ?a ?æ ?b ?b ?d ?e ?e ?g ?h ?i ?j ?k ?l ?m ?n ?n ?o ?p ?r ᵀ>t ?u ?w ?a ?a ?æ ?b ?d ?e ?e ?e ?g ?i ?k ?m ?o ?o ?o ?o ?p ?t ?u ?u ?m ?v ?i ?r ?u ?v ?b ?d ?f ?m ?n ?p ?r ?r ?s ?t ?z ?g ?g ?i ?p ?u ᶀ>b ?d ?f ?g ?k ?l ?m ?n ?p ?r ?s ?v ?x ?z ?a ?d ?e ?e ?e ?i ?o ?u ?c ?c ?e ?f ?j ?g ?h ?i ?i ?i ?j ?l ?l ?l ?m ?m ?n ?n ?n ?o ?s ?t ?u ?u ?v ?v ?z ?z ?z ?r */
-//0x1e 0x1f00
-const static u2 table_30[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x61,0x61,0x62,0x62,0x62,0x62,0x62,0x62,0x63,0x63,0x64,0x64,0x64,0x64,0x64,0x64,
 0x64,0x64,0x64,0x64,0x65,0x65,0x65,0x65,0x65,0x65,0x65,0x65,0x65,0x65,0x66,0x66,
 0x67,0x67,0x68,0x68,0x68,0x68,0x68,0x68,0x68,0x68,0x68,0x68,0x69,0x69,0x69,0x69,
@@ -288,12 +290,9 @@ const static u2 table_30[] = {
 0x65,0x65,0x65,0x65,0x65,0x65,0x65,0x65,0x69,0x69,0x69,0x69,0x6f,0x6f,0x6f,0x6f,
 0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,0x6f,
 0x6f,0x6f,0x6f,0x6f,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,0x75,
-0x75,0x75,0x79,0x79,0x79,0x79,0x79,0x79,0x79,0x79,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-Ḁ>a ?a ?b ?b ?b ?b ?b ?b ?c ?c ?d ?d ?d ?d ?d ?d ?d ?d ?d ?d ?e ?e ?e ?e ?e ?e ?e ?e ?e ?e ?f ?f ?g ?g ?h ?h ?h ?h ?h ?h ?h ?h ?h ?h ?i ?i ?i ?i ?k ?k ?k ?k ?k ?k ?l ?l ?l ?l ?l ?l ?l ?l ?m ?m Ṁ>m ?m ?m ?m ?n ?n ?n ?n ?n ?n ?n ?n ?o ?o ?o ?o ?o ?o ?o ?o ?p ?p ?p ?p ?r ?r ?r ?r ?r ?r ?r ?r ?s ?s ?s ?s ?s ?s ?s ?s ?s ?s ?t ?t ?t ?t ?t ?t ?t ?t ?u ?u ?u ?u ?u ?u ?u ?u ?u ?u ?v ?v ?v ?v Ẁ>w ?w ?w ?w ?w ?w ?w ?w ?w ?w ?x ?x ?x ?x ?y ?y ?z ?z ?z ?z ?z ?z ?h ?t ?w ?y ?a ?s ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?a ?e ?e ?e ?e ?e ?e ?e ?e Ề>e ?e ?e ?e ?e ?e ?e ?e ?i ?i ?i ?i ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?o ?u ?u ?u ?u ?u ?u ?u ?u ?u ?u ?u ?u ?u ?u ?y ?y ?y ?y ?y ?y ?y ?y */
-//0x1f 0x2000
-const static u2 table_31[] = {
+0x75,0x75,0x79,0x79,0x79,0x79,0x79,0x79,0x79,0x79,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,0x3b1,
 0x3b5,0x3b5,0x3b5,0x3b5,0x3b5,0x3b5,0x0,0x0,0x3b5,0x3b5,0x3b5,0x3b5,0x3b5,0x3b5,0x0,0x0,
 0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,0x3b7,
@@ -309,12 +308,9 @@ const static u2 table_31[] = {
 0x0,0x0,0x3b7,0x3b7,0x3b7,0x0,0x3b7,0x3b7,0x3b5,0x3b5,0x3b7,0x3b7,0x3b7,0x0,0x0,0x0,
 0x3b9,0x3b9,0x3b9,0x3b9,0x0,0x0,0x3b9,0x3b9,0x3b9,0x3b9,0x3b9,0x3b9,0x0,0x0,0x0,0x0,
 0x3c5,0x3c5,0x3c5,0x3c5,0x3c1,0x3c1,0x3c5,0x3c5,0x3c5,0x3c5,0x3c5,0x3c5,0x3c1,0x0,0x0,0x0,
-0x0,0x0,0x3c9,0x3c9,0x3c9,0x0,0x3c9,0x3c9,0x3bf,0x3bf,0x3c9,0x3c9,0x3c9,0x0,0x0,0x0
-};
-/*
-ἀ>α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?ε ?ε ?ε ?ε ?ε ?ε ?ε ?ε ?ε ?ε ?ε ?ε ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ὀ>ο ?ο ?ο ?ο ?ο ?ο ?ο ?ο ?ο ?ο ?ο ?ο ?υ ?υ ?υ ?υ ?υ ?υ ?υ ?υ ?υ ?υ ?υ ?υ ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?α ?α ?ε ?ε ?η ?η ?ι ?ι ?ο ?ο ?υ ?υ ?ω ?ω ᾀ>α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?η ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?ω ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?α ?η ?η ?η ?η ?η ?ε ?ε ?η ?η ?η ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?ι ?υ ?υ ?υ ?υ ?ρ ?ρ ?υ ?υ ?υ ?υ ?υ ?υ ?ρ ?ω ?ω ?ω ?ω ?ω ?ο ?ο ?ω ?ω ?ω */
-//0x20 0x2100
-const static u2 table_32[] = {
+0x0,0x0,0x3c9,0x3c9,0x3c9,0x0,0x3c9,0x3c9,0x3bf,0x3bf,0x3c9,0x3c9,0x3c9,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x27,0x0,0x0,0x0,0x22,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -330,12 +326,9 @@ const static u2 table_32[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?' ?" ?i ?n ?a ?e ?o ?x */
-//0x21 0x2200
-const static u2 table_33[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x68,0x0,0x0,0x0,
 0x0,0x69,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x72,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x7a,0x0,0x0,0x0,0x0,0x63,0x0,0x0,
@@ -351,12 +344,9 @@ const static u2 table_33[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?h ?i ?r ?z ?c ?c */
-//0x2c 0x2d00
-const static u2 table_44[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -372,12 +362,9 @@ const static u2 table_44[] = {
 0x2cc1,0x0,0x2cc3,0x0,0x2cc5,0x0,0x2cc7,0x0,0x2cc9,0x0,0x2ccb,0x0,0x2ccd,0x0,0x2ccf,0x0,
 0x2cd1,0x0,0x2cd3,0x0,0x2cd5,0x0,0x2cd7,0x0,0x2cd9,0x0,0x2cdb,0x0,0x2cdd,0x0,0x2cdf,0x0,
 0x2ce1,0x0,0x2ce3,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?l ?l ?l ?p ?r ?a ?t ?h ?h ?k ?k ?z ?z ?v ?h ?h Ⲁ>????????????????????????????????o ????????????????????????????????Ⳁ>???????????????????????????????????*/
-//0x2f 0x3000
-const static u2 table_47[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x4e00,0x4e28,0x4e36,0x4e3f,0x4e59,0x4e85,0x4e8c,0x4ea0,0x4eba,0x513f,0x5165,0x516b,0x5182,0x5196,0x51ab,0x51e0,
 0x51f5,0x5200,0x529b,0x52f9,0x5315,0x531a,0x5338,0x5341,0x535c,0x5369,0x5382,0x53b6,0x53c8,0x53e3,0x56d7,0x571f,
 0x58eb,0x5902,0x590a,0x5915,0x5927,0x5973,0x5b50,0x5b80,0x5bf8,0x5c0f,0x5c22,0x5c38,0x5c6e,0x5c71,0x5ddb,0x5de5,
@@ -393,12 +380,9 @@ const static u2 table_47[] = {
 0x9b32,0x9b3c,0x9b5a,0x9ce5,0x9e75,0x9e7f,0x9ea5,0x9ebb,0x9ec3,0x9ecd,0x9ed1,0x9ef9,0x9efd,0x9f0e,0x9f13,0x9f20,
 0x9f3b,0x9f4a,0x9f52,0x9f8d,0x9f9c,0x9fa0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-⼀>一 ?????????????????????????????????刀 ???????????????????????????????????????????宀 ????????????????????????????????????????????????⽀>???????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????⾀>????????????????????????????血 ???????????言 ???????????????????????????????????????門 ??????????????????????????????????????????????⿀>???????????????????????????????????????????*/
-//0x30 0x3100
-const static u2 table_48[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x2c,0x0,0x0,0x0,0x0,0x0,0x0,0x3e,0x3c,0x3c,0x3e,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -414,12 +398,9 @@ const static u2 table_48[] = {
 0x30bf,0x0,0x30c1,0x0,0x0,0x30c4,0x0,0x30c6,0x31f3,0x30c8,0x0,0x0,0x31f4,0x0,0x0,0x31f5,
 0x30cf,0x30cf,0x31f6,0x30d2,0x30d2,0x31f7,0x30d5,0x30d5,0x31f8,0x30d8,0x30d8,0x31f9,0x30db,0x30db,0x0,0x0,
 0x31fa,0x0,0x0,0x0,0x30e3,0x0,0x30e5,0x0,0x30e7,0x31fb,0x31fc,0x31fd,0x31fe,0x31ff,0x0,0x30ee,
-0x0,0x0,0x0,0x0,0x30a6,0x0,0x0,0x30ef,0x30f0,0x30f1,0x30f2,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?, ?> ?< ?< ?> ????????????????????????????????????????????????????????????????????????????????????????????????????????????????????ダ>?????????????????????????????????????????????????????????????????????????*/
-//0x31 0x3200
-const static u2 table_49[] = {
+0x0,0x0,0x0,0x0,0x30a6,0x0,0x0,0x30ef,0x30f0,0x30f1,0x30f2,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -435,12 +416,9 @@ const static u2 table_49[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-?ᄀ ????????????????????????????ㅀ>????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????ᅀ ㆀ>?????????????????????????????*/
-//0xa4 0xa500
-const static u2 table_164[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
@@ -456,12 +434,9 @@ const static u2 table_164[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-????*/
-//0xf9 0xfa00
-const static u2 table_249[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x8c48,0x66f4,0x8eca,0x8cc8,0x6ed1,0x4e32,0x53e5,0x9f9c,0x9f9c,0x5951,0x91d1,0x5587,0x5948,0x61f6,0x7669,0x7f85,
 0x863f,0x87ba,0x88f8,0x908f,0x6a02,0x6d1b,0x70d9,0x73de,0x843d,0x916a,0x99f1,0x4e82,0x5375,0x6b04,0x721b,0x862d,
 0x9e1e,0x5d50,0x6feb,0x85cd,0x8964,0x62c9,0x81d8,0x881f,0x5eca,0x6717,0x6d6a,0x72fc,0x90ce,0x4f86,0x51b7,0x52de,
@@ -477,12 +452,9 @@ const static u2 table_249[] = {
 0x71ce,0x7642,0x84fc,0x907c,0x9f8d,0x6688,0x962e,0x5289,0x677b,0x67f3,0x6d41,0x6e9c,0x7409,0x7559,0x786b,0x7d10,
 0x985e,0x516d,0x622e,0x9678,0x502b,0x5d19,0x6dea,0x8f2a,0x5f8b,0x6144,0x6817,0x7387,0x9686,0x5229,0x540f,0x5c65,
 0x6613,0x674e,0x68a8,0x6ce5,0x7406,0x75e2,0x7f79,0x88cf,0x88e1,0x91cc,0x96e2,0x533f,0x6eba,0x541d,0x71d0,0x7498,
-0x85fa,0x96a3,0x9c57,0x9e9f,0x6797,0x6dcb,0x81e8,0x7acb,0x7b20,0x7c92,0x72c0,0x7099,0x8b58,0x4ec0,0x8336,0x523a
-};
-/*
-豈>???????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????????鹿>????????????????????????????????????????????????????讀 ??????????????????????????????????????????????????????????????????????????呂>????????????????????????????????戀 ??????????????????????????????????????????????????????????????????????????????????????????????燎>????????????????????????????????????????????????????????????????????????????????????????????????????????????????????狀 ?????什 ????*/
-//0xfa 0xfb00
-const static u2 table_250[] = {
+0x85fa,0x96a3,0x9c57,0x9e9f,0x6797,0x6dcb,0x81e8,0x7acb,0x7b20,0x7c92,0x72c0,0x7099,0x8b58,0x4ec0,0x8336,0x523a,
+},
+{
 0x5207,0x5ea6,0x62d3,0x7cd6,0x5b85,0x6d1e,0x66b4,0x8f3b,0x884c,0x964d,0x898b,0x5ed3,0x5140,0x55c0,0x0,0x0,
 0x585a,0x0,0x6674,0x0,0x0,0x51de,0x732a,0x76ca,0x793c,0x795e,0x7965,0x798f,0x9756,0x7cbe,0x7fbd,0x0,
 0x8612,0x0,0x8af8,0x0,0x0,0x9038,0x90fd,0x0,0x0,0x0,0x98ef,0x98fc,0x9928,0x9db4,0x0,0x0,
@@ -498,12 +470,9 @@ const static u2 table_250[] = {
 0x8b8a,0x8d08,0x8f38,0x9072,0x9199,0x9276,0x967c,0x96e3,0x9756,0x97db,0x97ff,0x980b,0x983b,0x9b12,0x9f9c,0x0,
 0x0,0x0,0x3b9d,0x4018,0x4039,0x0,0x0,0x0,0x9f43,0x9f8e,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
-};
-/*
-切>????????????????????????兀 ?嗀 ???????????????????????????????????????????????????????????塀 ????????????懲>????????????????????????????????????????穀 ???節 ???????????????????????????????????????????????侀 ???冀 ????????????????????婢>????????????????????????????????????????????????????????????????????????????????????着 ?????節 ????????????????????????????????????變>???????????????????????????????????????*/
-//0xfb 0xfc00
-const static u2 table_251[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
+{
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x5d9,0x0,0x5f2,
 0x5e2,0x5d0,0x5d3,0x5d4,0x5db,0x5dc,0x5dd,0x5e8,0x5ea,0x0,0x5e9,0x5e9,0x5e9,0x5e9,0x5d0,0x5d0,
@@ -519,12 +488,9 @@ const static u2 table_251[] = {
 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
 0x0,0x0,0x0,0x6ad,0x6ad,0x6ad,0x0,0x6c7,0x6c7,0x6c6,0x6c6,0x6c8,0x6c8,0x677,0x6cb,0x6cb,
 0x6c5,0x6c5,0x6c9,0x6c9,0x6d0,0x6d0,0x6d0,0x0,0x649,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x6cc,0x6cc,0x6cc,0x0
-};
-/*
-?י ?ײ ?ע ?א ?ד ?ה ?כ ?ל ?ם ?ר ?ת ?ש ?ש ?ש ?ש ?א ?א ?א ?ב ?ג ?ד ?ה ?ו ?ז ?ט ?י ?ך ?כ ?ל ?מ נּ>נ ?ס ?ף ?פ ?צ ?ק ?ר ?ש ?ת ?ו ?ב ?כ ?פ ?א ?ٱ ?ٱ ?ٻ ?ٻ ?ٻ ?پ ?پ ?پ ?ڀ ?ڀ ?ڀ ?ٺ ?ٺ ?ٺ ?ٿ ?ٿ ?ٿ ?ٹ ?ٹ ?ٹ ?ڤ ?ڤ ?ڤ ?ڦ ?ڦ ?ڦ ?ڄ ?ڄ ?ڄ ?ڃ ?ڃ ?ڃ ?چ ?چ ?چ ?ڇ ?ڇ ﮀ>ڇ ?ڍ ?ڍ ?ڌ ?ڌ ?ڎ ?ڎ ?ڈ ?ڈ ?ژ ?ژ ?ڑ ?ڑ ?ک ?ک ?ک ?گ ?گ ?گ ?ڳ ?ڳ ?ڳ ?ڱ ?ڱ ?ڱ ?ں ?ں ?ڻ ?ڻ ?ڻ ?ۀ ?ۀ ?ہ ?ہ ?ہ ?ھ ?ھ ?ھ ?ے ?ے ?ۓ ?ۓ ?ڭ ?ڭ ?ڭ ?ۇ ?ۇ ?ۆ ?ۆ ?ۈ ?ۈ ?ٷ ?ۋ ?ۋ ?ۅ ?ۅ ?ۉ ?ۉ ?ې ?ې ?ې ?ى ?ی ?ی ?ی */
-//0xff 0x10000
-const static u2 table_255[] = {
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x6cc,0x6cc,0x6cc,0x0,
+},
+{
 0x0,0x21,0x0,0x23,0x0,0x25,0x0,0x0,0x28,0x29,0x2a,0x2b,0x0,0x2d,0x0,0x2f,
 0x30,0x31,0x32,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3a,0x3b,0x0,0x3d,0x0,0x3f,
 0x0,0x61,0x62,0x63,0x64,0x65,0x66,0x67,0x68,0x69,0x6a,0x6b,0x6c,0x6d,0x6e,0x6f,
@@ -540,9 +506,6 @@ const static u2 table_255[] = {
 0x0,0x0,0x314f,0x3150,0x3151,0x3152,0x3153,0x3154,0x0,0x0,0x3155,0x3156,0x3157,0x3158,0x3159,0x315a,
 0x0,0x0,0x315b,0x315c,0x315d,0x315e,0x315f,0x3160,0x0,0x0,0x3161,0x3162,0x3163,0x0,0x0,0x0,
 0x0,0x0,0x0,0x0,0x0,0x24,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
-0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0
+0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0,
+},
 };
-/*
-?! ?# ?% ?( ?) ?* ?+ ?- ?/ ?0 ?1 ?2 ?3 ?4 ?5 ?6 ?7 ?8 ?9 ?: ?; ?= ?? ?a ?b ?c ?d ?e ?f ?g ?h ?i ?j ?k ?l ?m ?n ?o ?p ?q ?r ?s ?t ?u ?v ?w ?x ?y ?z ?[ ?] ｀>` ?a ?b ?c ?d ?e ?f ?g ?h ?i ?j ?k ?l ?m ?n ?o ?p ?q ?r ?s ?t ?u ?v ?w ?x ?y ?z ?{ ?| ?} ?~ ??????????????????????????????????????????????????ﾀ>????????????????????????????????????????????????????????????????????????????????????????????ㅀ ???????????????????????????????????????????????????????????????????????$ */
-const static u2* table_index[] = {
-table_0 , table_1 , table_2 , table_3 , table_4 , table_5 , table_6 , NULL , NULL , table_9 , table_10 , table_11 , NULL , NULL , NULL , NULL , table_16 , NULL , NULL , NULL , NULL , NULL , table_22 , NULL , NULL , NULL , NULL , NULL , NULL , table_29 , table_30 , table_31 , table_32 , table_33 , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , table_44 , NULL , NULL , table_47 , table_48 , table_49 , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , table_164 , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , NULL , table_249 , table_250 , table_251 , NULL , NULL , NULL , table_255 };
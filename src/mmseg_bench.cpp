@@ -0,0 +1,348 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <cstdio>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "bsd_getopt.h"
+#include "mmseg_proto.h"
+#include "SegmenterManager.h"
+#include "Segmenter.h"
+
+/*
+mmseg-bench, the load generator of mmseg-server.
+Each line of the input file is a document, every connection keeps <depth> requests
+in flight, and the latency of each request is recorded to report p50/p99.
+With -d, the lines are segmented in process instead, as queries by Segmenter::segmentQuery
+and as documents by setBuffer and peekToken, timing each call in ns.
+*/
+
+struct BenchConfig {
+	const char* sock_path;
+	int port;
+	int requests;	//per connection
+	int depth;		//pipeline depth
+	int batch;		//documents per request
+	std::vector<std::string>* docs;
+};
+
+struct BenchResult {
+	std::vector<u4> latency;	//in us
+	u8 docs;
+	u8 bytes;
+	u8 tokens;
+	int failed;
+};
+
+struct BenchThread {
+	pthread_t tid;
+	int index;
+	BenchConfig* config;
+	BenchResult result;
+};
+
+static u8 now_us()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u8)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static u8 now_ns()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u8)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void usage(const char* argv_0) {
+	printf("Coreseek COS(tm) MM Segment Server Benchmark 1.0\n");
+	printf("Copyright By Coreseek.com All Right Reserved.\n");
+	printf("Usage: %s <option> <file>\n",argv_0);
+	printf("-s <socket>      connect to unix domain socket\n");
+	printf("-p <port>        connect to 127.0.0.1:<port>, if -s not assigned\n");
+	printf("-c <num>         concurrent connections, default 4\n");
+	printf("-n <num>         requests per connection, default 10000\n");
+	printf("-P <num>         pipeline depth, requests in flight per connection, default 8\n");
+	printf("-b <num>         documents per request, default 1\n");
+	printf("-d <dict_path>   segment in process, no server: each line as a query and as a document,\n");
+	printf("                 -n rounds over the lines\n");
+	printf("-h               print this help and exit\n");
+	printf("each line of <file> is used as a document.\n");
+	return;
+}
+
+static void build_request(BenchConfig* config, u4 id, size_t& next_doc, std::vector<char>& req, BenchResult& result)
+{
+	std::vector<std::string>& docs = *config->docs;
+	req.resize(MMSEG_PROTO_HEADER_SIZE);
+	mmseg_put_u4(&req[sizeof(u4)], id);
+	mmseg_put_u4(&req[sizeof(u4)*2], config->batch);
+	for(int i = 0; i < config->batch; i++) {
+		const std::string& doc = docs[next_doc];
+		next_doc = (next_doc + 1) % docs.size();
+		size_t pos = req.size();
+		req.resize(pos + sizeof(u4) + doc.size());
+		mmseg_put_u4(&req[pos], (u4)doc.size());
+		memcpy(&req[pos + sizeof(u4)], doc.data(), doc.size());
+		result.bytes += doc.size();
+	}
+	mmseg_put_u4(&req[0], (u4)(req.size() - sizeof(u4)));
+}
+
+static void print_latency(const char* name, std::vector<u4>& latency, u8 tokens)
+{
+	std::sort(latency.begin(), latency.end());
+	size_t n = latency.size();
+	u8 total = 0;
+	for(size_t i = 0; i < n; i++)
+		total += latency[i];
+	printf("%s: %lu calls, %llu tokens, latency(ns): avg %llu, p50 %u, p99 %u, max %u\n", name,
+		(unsigned long)n, tokens, total / n, latency[n/2],
+		latency[(n*99)/100 < n ? (n*99)/100 : n - 1], latency[n - 1]);
+}
+
+//both paths over the same lines.
+static int bench_local(const char* dict_path, std::vector<std::string>& docs, int rounds)
+{
+	css::SegmenterManager mgr;
+	if(mgr.init(dict_path) != 0) {
+		fprintf(stderr, "Can't load dict from %s\n", dict_path);
+		return 1;
+	}
+	css::Segmenter* seg = mgr.getSegmenter(false);
+	std::vector<u4> query_latency, doc_latency;
+	query_latency.reserve(docs.size() * rounds);
+	doc_latency.reserve(docs.size() * rounds);
+	u8 query_tokens = 0, doc_tokens = 0;
+	std::vector<u4> offsets, expect;
+	int mismatch = 0;
+	for(int r = 0; r < rounds; r++) {
+		for(size_t i = 0; i < docs.size(); i++) {
+			u1* buf = (u1*)docs[i].c_str();
+			u4 length = (u4)docs[i].size();
+			offsets.resize(length * 2 + 2);
+			//the first call sees the line cold, take turns.
+			for(int k = 0; k < 2; k++) {
+				if((k ^ (int)(i & 1)) == 0) {
+					u8 t0 = now_ns();
+					u4 n = seg->segmentQuery(buf, length, &offsets[0], length + 1);
+					query_latency.push_back((u4)(now_ns() - t0));
+					query_tokens += n;
+					offsets.resize(n * 2);
+					continue;
+				}
+				expect.clear();
+				u8 t0 = now_ns();
+				seg->setBuffer(buf, length);
+				while(1) {
+					u2 len = 0, symlen = 0;
+					const u1* tok = seg->peekToken(len, symlen);
+					if(!tok || !*tok || !len)
+						break;
+					u4 start = (u4)seg->getOffset();
+					seg->popToken(len);
+					expect.push_back(start);
+					expect.push_back(start + len);
+				}
+				doc_latency.push_back((u4)(now_ns() - t0));
+				doc_tokens += expect.size() / 2;
+			}
+			if(!r && expect != offsets)
+				mismatch++;
+		}
+	}
+	seg->flushStats();
+	delete seg;
+	print_latency("query", query_latency, query_tokens);
+	print_latency("document", doc_latency, doc_tokens);
+	if(mismatch)
+		fprintf(stderr, "%d line(s) segmented differently\n", mismatch);
+	return mismatch ? 1 : 0;
+}
+
+static void* bench_main(void* arg)
+{
+	BenchThread* self = (BenchThread*)arg;
+	BenchConfig* config = self->config;
+	BenchResult& result = self->result;
+	result.docs = result.bytes = result.tokens = 0;
+	result.failed = 0;
+
+	int fd = mmseg_connect(config->sock_path, config->port);
+	if(fd < 0) {
+		result.failed = 1;
+		return NULL;
+	}
+	std::vector<u8> sent(config->requests);
+	std::vector<char> req;
+	std::vector<char> resp;
+	size_t next_doc = (self->index * 7919) % config->docs->size();
+	int nsent = 0, nrecv = 0;
+	while(nrecv < config->requests) {
+		while(nsent < config->requests && nsent - nrecv < config->depth) {
+			build_request(config, nsent, next_doc, req, result);
+			sent[nsent] = now_us();
+			if(mmseg_write_full(fd, &req[0], req.size()) != 0) {
+				result.failed = 1;
+				close(fd);
+				return NULL;
+			}
+			nsent++;
+		}
+		char head[sizeof(u4)];
+		if(mmseg_read_full(fd, head, sizeof(head)) != 0) {
+			result.failed = 1;
+			break;
+		}
+		u4 len = mmseg_get_u4(head);
+		resp.resize(len);
+		if(len < MMSEG_PROTO_HEADER_SIZE - sizeof(u4) || mmseg_read_full(fd, &resp[0], len) != 0) {
+			result.failed = 1;
+			break;
+		}
+		u4 id = mmseg_get_u4(&resp[0]);
+		u4 count = mmseg_get_u4(&resp[sizeof(u4)]);
+		if(id >= (u4)config->requests || count != (u4)config->batch) {
+			result.failed = 1;
+			break;
+		}
+		result.latency.push_back((u4)(now_us() - sent[id]));
+		const char* ptr = &resp[sizeof(u4)*2];
+		for(u4 i = 0; i < count; i++) {
+			u4 ntok = mmseg_get_u4(ptr);
+			ptr += sizeof(u4) + ntok*sizeof(u4)*2;
+			result.tokens += ntok;
+		}
+		result.docs += count;
+		nrecv++;
+	}
+	close(fd);
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	int c;
+	BenchConfig config;
+	config.sock_path = NULL;
+	config.port = 0;
+	config.requests = 10000;
+	config.depth = 8;
+	config.batch = 1;
+	int conns = 4;
+	const char* dict_path = NULL;
+
+	while ((c = getopt(argc, argv, "s:p:c:n:P:b:d:h")) != -1) {
+		switch (c) {
+		case 's':
+			config.sock_path = optarg;
+			break;
+		case 'p':
+			config.port = atoi(optarg);
+			break;
+		case 'c':
+			conns = atoi(optarg);
+			break;
+		case 'n':
+			config.requests = atoi(optarg);
+			break;
+		case 'P':
+			config.depth = atoi(optarg);
+			break;
+		case 'b':
+			config.batch = atoi(optarg);
+			break;
+		case 'd':
+			dict_path = optarg;
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(0);
+		default:
+			fprintf(stderr, "Illegal argument \"%c\"\n", c);
+			return 1;
+		}
+	}
+	if(optind >= argc || (!dict_path && !config.sock_path && config.port <= 0) || conns <= 0
+		|| config.requests <= 0 || config.depth <= 0 || config.batch <= 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::vector<std::string> docs;
+	{
+		std::ifstream is(argv[optind]);
+		std::string line;
+		while(std::getline(is, line)) {
+			if(!line.empty())
+				docs.push_back(line);
+		}
+	}
+	if(docs.empty()) {
+		fprintf(stderr, "No document in %s\n", argv[optind]);
+		return 1;
+	}
+	config.docs = &docs;
+	if(dict_path)
+		return bench_local(dict_path, docs, config.requests);
+
+	std::vector<BenchThread> threads(conns);
+	u8 begin = now_us();
+	for(int i = 0; i < conns; i++) {
+		threads[i].index = i;
+		threads[i].config = &config;
+		pthread_create(&threads[i].tid, NULL, bench_main, &threads[i]);
+	}
+	std::vector<u4> latency;
+	u8 ndocs = 0, nbytes = 0, ntokens = 0;
+	int failed = 0;
+	for(int i = 0; i < conns; i++) {
+		pthread_join(threads[i].tid, NULL);
+		BenchResult& r = threads[i].result;
+		latency.insert(latency.end(), r.latency.begin(), r.latency.end());
+		ndocs += r.docs;
+		nbytes += r.bytes;
+		ntokens += r.tokens;
+		failed += r.failed;
+	}
+	double elapsed = (now_us() - begin) / 1000000.0;
+	if(failed)
+		fprintf(stderr, "%d connection(s) failed\n", failed);
+	if(latency.empty())
+		return 1;
+	std::sort(latency.begin(), latency.end());
+	size_t n = latency.size();
+	printf("requests: %lu, documents: %llu, tokens: %llu, bytes: %llu\n",
+		(unsigned long)n, ndocs, ntokens, nbytes);
+	printf("elapsed: %.3f s, %.0f req/s, %.0f docs/s, %.2f MB/s\n",
+		elapsed, n / elapsed, ndocs / elapsed, nbytes / elapsed / 1024 / 1024);
+	printf("latency(us): p50 %u, p99 %u, max %u\n",
+		latency[n/2], latency[(n*99)/100 < n ? (n*99)/100 : n - 1], latency[n - 1]);
+	return failed ? 1 : 0;
+}
@@ -41,6 +41,14 @@
 #include "ThesaurusDict.h"
 #include "SegmenterManager.h"
 #include "Segmenter.h"
+#include "KeywordExtractor.h"
+#include "DictBundle.h"
+#include "SegmentTrace.h"
+#include "Transcoder.h"
+#ifndef WIN32
+#include "SegmentPipeline.h"
+#include "SegmentExecutor.h"
+#endif
 #include "csr_utils.h"
 
 using namespace std;
@@ -56,10 +64,27 @@ void usage(const char* argv_0) {
 	printf("-r           Combine with -u, used a plain text build Unigram Dictionary, default Off\n");
 	printf("-b <Synonyms>           Synonyms Dictionary\n");
 	printf("-t <thesaurus>          Thesaurus Dictionary\n");
+	printf("-k <num>      Combine with -d, print top <num> keywords of file instead of segment result\n");
+	printf("-S            Combine with -d, print the segmenter counters to stderr when done\n");
+#ifndef WIN32
+	printf("-p            Combine with -d, read and tag file in a second thread while segmenting, for long files\n");
+	printf("-j <num>      Combine with -d, segment file on <num> threads, split at lines and separators;\n");
+	printf("              tokens are printed as in the file, without synonyms\n");
+#endif
+	printf("-e <encoding> Combine with -d, encoding of file: auto(default), utf-8, utf-16le, utf-16be, gbk, gb18030\n");
+	printf("-T <file>     Combine with -d, trace every MMSEG decision into <file>, read it by mmseg-trace\n");
+	printf("-B <dict_path>          Pack the dictionaries and mmseg.ini of dict_path into one bundle file,\n");
+	printf("              written to -o <file>, default mmseg.bundle. -d accepts the bundle file as dict_path\n");
 	printf("-h            print this help and exit\n");
 	return;
 }
-int segment(const char* file,Segmenter* seg, u1 bQuite = 0);
+int segment(const char* file,Segmenter* seg, u1 bQuite = 0, int encoding = Transcoder::ENC_AUTO);
+#ifndef WIN32
+int segment_pipelined(const char* file,Segmenter* seg, u1 bQuite, int encoding);
+int segment_parallel(const char* file,SegmenterManager* mgr, Segmenter* seg, int threads, u1 bQuite, int encoding);
+#endif
+int keywords(const char* file,Segmenter* seg, int topk, int encoding = Transcoder::ENC_AUTO);
+void print_stats(const SegmentStats& st);
 /*
 Use this program 
 Usage:
@@ -67,7 +92,7 @@ Usage:
 ./ngram [-d dict_path] [file] [outfile] 
 Do segment. Will print segment result to stdout
 -d the path with contains unidict & bidict
-file: the file to be segment, must encoded in UTF-8 format. [*nix only] if file=='-', read data from stdin
+file: the file to be segment, in UTF-8, UTF-16, GBK or GB18030, see -e. [*nix only] if file=='-', read data from stdin
 2)
 ./ngram -u file [outfile]
 Build unigram dictionary from corpus file. 
@@ -90,6 +115,7 @@ int main(int argc, char **argv) {
 	const char* out_file = NULL;
 	const char* dict_path = NULL;
 	const char* target_file = NULL;
+	const char* bundle_path = NULL;
 	char out_buf[512];
 	
 	if(argc < 2){
@@ -99,7 +125,13 @@ int main(int argc, char **argv) {
 	u1 bPlainText = 0;
 	u1 bQuite = 0;
 	u1 bUcs2 = 0;
-	while ((c = getopt(argc, argv, "t:b:u:d:o:rqU")) != -1) {
+	int topk = 0;
+	u1 bStats = 0;
+	u1 bPipelined = 0;
+	int threads = 0;
+	const char* trace_file = NULL;
+	int encoding = Transcoder::ENC_AUTO;
+	while ((c = getopt(argc, argv, "t:b:u:d:o:k:B:T:e:j:rqSUp")) != -1) {
 		switch (c) {
 		case 'o':
 			target_file = optarg;
@@ -116,13 +148,40 @@ int main(int argc, char **argv) {
 		case 't':
 			thesaurus_file = optarg;
 			break;
+		case 'k':
+			topk = atoi(optarg);
+			break;
+		case 'B':
+			bundle_path = optarg;
+			break;
 		case 'r':
 			bPlainText = 1;
 			break;
 		case 'q':
 			bQuite = 1;
 			break;
+		case 'S':
+			bStats = 1;
+			break;
+#ifndef WIN32
+		case 'p':
+			bPipelined = 1;
+			break;
+#endif
+		case 'j':
+			threads = atoi(optarg);
+			break;
+		case 'T':
+			trace_file = optarg;
+			break;
 
+		case 'e':
+			encoding = Transcoder::parseName(optarg);
+			if(encoding < 0) {
+				fprintf(stderr, "Unknown encoding \"%s\"\n", optarg);
+				return 1;
+			}
+			break;
 		case 'U':
 			bUcs2 = 1;
 			break;
@@ -139,6 +198,15 @@ int main(int argc, char **argv) {
 		out_file = argv[optind];
 	}
 
+	if(bundle_path) {
+		if(!target_file)
+			target_file = "mmseg.bundle";
+		int nRet = DictBundle::build(bundle_path, target_file);
+		if(nRet != 0)
+			printf("Bundle build Error(%d), %s\n", nRet, target_file);
+		return nRet;
+	}
+
 	if(thesaurus_file) {
 		ThesaurusDict tdict;
 		tdict.import(thesaurus_file, target_file);
@@ -223,7 +291,26 @@ int main(int argc, char **argv) {
 			//init ok, do segment.
 			setlocale(LC_ALL, ""); //fix in chinese filename for win32
 			Segmenter* seg = mgr->getSegmenter();
-			segment(out_file,seg, bQuite);
+			if(trace_file)
+				SegmentTrace::setSampling(1);
+			if(topk > 0)
+				keywords(out_file, seg, topk, encoding);
+#ifndef WIN32
+			else if(threads > 0)
+				segment_parallel(out_file, mgr, seg, threads, bQuite, encoding);
+			else if(bPipelined)
+				segment_pipelined(out_file, seg, bQuite, encoding);
+#endif
+			else
+				segment(out_file,seg, bQuite, encoding);
+			if(bStats) {
+				SegmentStats st;
+				seg->flushStats();
+				mgr->getStats(&st);
+				print_stats(st);
+			}
+			if(trace_file && SegmentTrace::dump(trace_file) != 0)
+				printf("Can NOT write trace file %s\n", trace_file);
 		}
 		delete mgr;
 	}
@@ -231,53 +318,48 @@ int main(int argc, char **argv) {
 	return 0;
 }
 
-int segment(const char* file,Segmenter* seg, u1 bQuite)
+//print the thesaurus items of tok, if any.
+void print_thesaurus(Segmenter* seg, const char* tok, u2 len)
 {
-	std::istream *is;
-
-	is = new std::ifstream(file, ios::in | ios::binary);
-	if (! *is) 
-		return -1;
+	const char* thesaurus_ptr = seg->thesaurus(tok, len);
+	while(thesaurus_ptr && *thesaurus_ptr) {
+		int n = strlen(thesaurus_ptr);
+		printf("%*.*s/s ",n,n,thesaurus_ptr);
+		thesaurus_ptr += n + 1; //move next
+	}
+}
 
-	std::string line;
-	int n = 0;
-	
-	unsigned long srch,str;
-	str = currentTimeMillis();
-	//load data.
-	int length;
-	is->seekg (0, ios::end);
-	length = is->tellg();
-	is->seekg (0, ios::beg);
-	char* buffer = new char [length+1];
-	is->read (buffer,length);
-	buffer[length] = 0;
-	//begin seg
-	seg->setBuffer((u1*)buffer,length);
+/*
+Print the tokens of the buffer set to seg, bFirst for the head of a text.
+*/
+void print_tokens(Segmenter* seg, u1 bFirst)
+{
 	u2 len = 0, symlen = 0;
 	u2 kwlen = 0, kwsymlen = 0;
-	//check 1st token.
-	unsigned char txtHead[3] = {239,187,191};
-	char* tok = (char*)seg->peekToken(len, symlen);
-	seg->popToken(len);
-	if(seg->isSentenceEnd()){
-		do {
-			char* kwtok = (char*)seg->peekToken(kwlen , kwsymlen,1);
-			if(kwsymlen)
-				printf("[kw]%*.*s/x ",kwsymlen,kwsymlen,kwtok);
-		}while(kwsymlen);
-	}
-	if(len == 3 && memcmp(tok,txtHead,sizeof(char)*3) == 0){
-		//check is 0xFEFF
-		//do nothing
-	}else{
-		printf("%*.*s/x ",symlen,symlen,tok);
-		//omni words at this pos
-		{
-			tok = (char*)seg->popOmniToken(len);
-			while(tok) {
-				printf("%*.*s/o ",len,len,tok);
-				tok = (char*)seg->popOmniToken(len);			
+	if(bFirst) {
+		//check 1st token.
+		unsigned char txtHead[3] = {239,187,191};
+		char* tok = (char*)seg->peekToken(len, symlen);
+		seg->popToken(len);
+		if(seg->isSentenceEnd()){
+			do {
+				char* kwtok = (char*)seg->peekToken(kwlen , kwsymlen,1);
+				if(kwsymlen)
+					printf("[kw]%*.*s/x ",kwsymlen,kwsymlen,kwtok);
+			}while(kwsymlen);
+		}
+		if(len == 3 && memcmp(tok,txtHead,sizeof(char)*3) == 0){
+			//check is 0xFEFF
+			//do nothing
+		}else{
+			printf("%*.*s/x ",symlen,symlen,tok);
+			//omni words at this pos
+			{
+				tok = (char*)seg->popOmniToken(len);
+				while(tok) {
+					printf("%*.*s/o ",len,len,tok);
+					tok = (char*)seg->popOmniToken(len);			
+				}
 			}
 		}
 	}
@@ -317,16 +399,39 @@ int segment(const char* file,Segmenter* seg, u1 bQuite)
 		}
 
 		//check thesaurus
-		{
-			const char* thesaurus_ptr = seg->thesaurus(tok, symlen);
-			while(thesaurus_ptr && *thesaurus_ptr) {
-				len = strlen(thesaurus_ptr);
-				printf("%*.*s/s ",len,len,thesaurus_ptr);
-				thesaurus_ptr += len + 1; //move next
-			}
-		}
+		print_thesaurus(seg, tok, symlen);
 		//printf("%s",tok);
 	}
+}
+
+int segment(const char* file,Segmenter* seg, u1 bQuite, int encoding)
+{
+	std::istream *is;
+
+	is = new std::ifstream(file, ios::in | ios::binary);
+	if (! *is) 
+		return -1;
+
+	std::string line;
+	int n = 0;
+	
+	unsigned long srch,str;
+	str = currentTimeMillis();
+	//load data.
+	int length;
+	is->seekg (0, ios::end);
+	length = is->tellg();
+	is->seekg (0, ios::beg);
+	char* buffer = new char [length+1];
+	is->read (buffer,length);
+	buffer[length] = 0;
+	//to UTF-8, not copied if it is.
+	std::vector<u1> text;
+	u4 text_length = 0;
+	u1* utf8 = Transcoder::toUtf8((u1*)buffer, length, encoding, text, &text_length);
+	//begin seg
+	seg->setBuffer(utf8, text_length);
+	print_tokens(seg, 1);
 	srch = currentTimeMillis() - str;
 	if (!bQuite) {
 		printf("\n\nWord Splite took: %d ms.\n", srch);
@@ -336,3 +441,125 @@ int segment(const char* file,Segmenter* seg, u1 bQuite)
 	
 	return 0;
 }
+
+#ifndef WIN32
+int segment_pipelined(const char* file,Segmenter* seg, u1 bQuite, int encoding)
+{
+	std::ifstream is(file, ios::in | ios::binary);
+	if (!is) 
+		return -1;
+	unsigned long srch,str;
+	str = currentTimeMillis();
+	StreamPipelineSource source(is);
+	SegmentPipeline pipeline;
+	if(pipeline.start(&source, seg->m_config, encoding) != 0)
+		return -1;
+	u1 bFirst = 1;
+	SegmentPkg* pkg;
+	while((pkg = pipeline.next()) != NULL) {
+		seg->setBuffer((u1*)pkg->m_buf, pkg->m_length, pkg->m_tag);
+		print_tokens(seg, bFirst);
+		bFirst = 0;
+	}
+	srch = currentTimeMillis() - str;
+	if (!bQuite) {
+		printf("\n\nWord Splite took: %lu ms.\n", srch);
+	}	
+	return 0;
+}
+
+int segment_parallel(const char* file,SegmenterManager* mgr, Segmenter* seg, int threads, u1 bQuite, int encoding)
+{
+	std::ifstream is(file, ios::in | ios::binary);
+	if (!is) 
+		return -1;
+	unsigned long srch,str;
+	str = currentTimeMillis();
+	int length;
+	is.seekg (0, ios::end);
+	length = is.tellg();
+	is.seekg (0, ios::beg);
+	char* buffer = new char [length+1];
+	is.read (buffer,length);
+	buffer[length] = 0;
+	std::vector<u1> text;
+	u4 text_length = 0;
+	u1* utf8 = Transcoder::toUtf8((u1*)buffer, length, encoding, text, &text_length);
+
+	SegmentExecutor executor;
+	if(executor.init(mgr, threads) != 0) {
+		delete[] buffer;
+		return -1;
+	}
+	SegmentJob job;
+	job.m_buffer = utf8;
+	job.m_length = text_length;
+	executor.submit(&job);
+	job.wait();
+	executor.shutdown();
+	for(size_t i = 0; i + 1 < job.m_offsets.size(); i += 2) {
+		const char* tok = (const char*)&utf8[job.m_offsets[i]];
+		int len = (int)(job.m_offsets[i + 1] - job.m_offsets[i]);
+		if(*tok == '\r')
+			continue;
+		if(*tok == '\n'){
+			printf("\n");
+			continue;
+		}
+		printf("%*.*s/x ",len,len,tok);
+		print_thesaurus(seg, tok, (u2)len);
+	}
+	srch = currentTimeMillis() - str;
+	if (!bQuite) {
+		printf("\n\nWord Splite took: %lu ms.\n", srch);
+	}	
+	delete[] buffer;
+	return 0;
+}
+#endif
+
+int keywords(const char* file,Segmenter* seg, int topk, int encoding)
+{
+	std::ifstream is(file, ios::in | ios::binary);
+	if (!is) 
+		return -1;
+	int length;
+	is.seekg (0, ios::end);
+	length = is.tellg();
+	is.seekg (0, ios::beg);
+	char* buffer = new char [length+1];
+	is.read (buffer,length);
+	buffer[length] = 0;
+	std::vector<u1> text;
+	u4 text_length = 0;
+	u1* utf8 = Transcoder::toUtf8((u1*)buffer, length, encoding, text, &text_length);
+
+	KeywordExtractor extractor;
+	KeywordItem* items = new KeywordItem[topk];
+	int n = extractor.extract(seg, utf8, text_length, items, topk);
+	for(int i = 0; i < n; i++)
+		printf("%*.*s\t%d\t%d\t%d\n", items[i].length, items[i].length, items[i].token,
+			items[i].tf, items[i].weight, items[i].score);
+	delete[] items;
+	delete[] buffer;
+	return 0;
+}
+
+void print_stats(const SegmentStats& st)
+{
+	if(!MMSEG_STATS) {
+		fprintf(stderr, "Counters are not compiled in, rebuild with MMSEG_STATS=1\n");
+		return;
+	}
+	fprintf(stderr, "bytes: %llu, chars: %llu, tokens: %llu\n", st.bytes, st.chars, st.tokens);
+	fprintf(stderr, "chunks: %llu, positions: %llu, candidates: %llu (%.2f per position, max %llu)\n",
+		st.chunks, st.positions, st.candidates,
+		st.positions ? (double)st.candidates / st.positions : 0.0, st.candidates_max);
+	fprintf(stderr, "decided by rule 1: %llu, rule 2: %llu, rule 3: %llu, rule 4: %llu\n",
+		st.rules[0], st.rules[1], st.rules[2], st.rules[3]);
+	fprintf(stderr, "findHits: %llu calls, %llu hits\n", st.find_hits, st.hits);
+	fprintf(stderr, "synonyms: %llu lookups, %llu hits; thesaurus: %llu lookups, %llu hits\n",
+		st.synonym_lookups, st.synonym_hits, st.thesaurus_lookups, st.thesaurus_hits);
+	fprintf(stderr, "time: lookup %.3f ms, tokenize %.3f ms\n",
+		st.lookup_ns / 1000000.0, st.tokenize_ns / 1000000.0);
+}
@@ -0,0 +1,143 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef _MMSEG_PROTO_H_
+#define _MMSEG_PROTO_H_
+
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "csr_typedefs.h"
+
+/*
+mmseg-server wire protocol. all integers are u4 in network byte order.
+
+request:
+	length		bytes follow this field
+	id			echoed back in the response
+	count		documents in this request, >= 1. (request batching)
+	count * (doc_length, doc_bytes[doc_length])		UTF-8 text
+response:
+	length
+	id
+	count
+	count * (token_count, token_count * (start, end))	byte offsets into the document
+
+A client can pipeline requests without waiting for responses. Responses are matched
+by id, requests of the same connection might be answered out of order.
+*/
+#define MMSEG_PROTO_HEADER_SIZE		12
+#define MMSEG_PROTO_MAX_FRAME		(64*1024*1024)
+
+inline void mmseg_put_u4(char* p, u4 v)
+{
+	v = htonl(v);
+	memcpy(p, &v, sizeof(u4));
+}
+
+inline u4 mmseg_get_u4(const char* p)
+{
+	u4 v;
+	memcpy(&v, p, sizeof(u4));
+	return ntohl(v);
+}
+
+/*
+@return 0, ok
+@return -1, error or peer closed.
+*/
+inline int mmseg_read_full(int fd, void* buf, size_t len)
+{
+	char* ptr = (char*)buf;
+	while(len) {
+		ssize_t n = read(fd, ptr, len);
+		if(n < 0 && errno == EINTR)
+			continue;
+		if(n <= 0)
+			return -1;
+		ptr += n;
+		len -= n;
+	}
+	return 0;
+}
+
+inline int mmseg_write_full(int fd, const void* buf, size_t len)
+{
+	const char* ptr = (const char*)buf;
+	while(len) {
+		ssize_t n = write(fd, ptr, len);
+		if(n < 0 && errno == EINTR)
+			continue;
+		if(n <= 0)
+			return -1;
+		ptr += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/*
+connect to unix socket sock_path, or 127.0.0.1:port if sock_path is NULL.
+@return the fd, -1 if failed.
+*/
+inline int mmseg_connect(const char* sock_path, int port)
+{
+	int fd = -1;
+	if(sock_path) {
+		struct sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, sock_path, sizeof(addr.sun_path) - 1);
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if(fd < 0)
+			return -1;
+		if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+			close(fd);
+			return -1;
+		}
+	}else{
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons((unsigned short)port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		fd = socket(AF_INET, SOCK_STREAM, 0);
+		if(fd < 0)
+			return -1;
+		if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+			close(fd);
+			return -1;
+		}
+		int one = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+	}
+	return fd;
+}
+
+#endif
@@ -0,0 +1,597 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <cstdio>
+#include <vector>
+#include <deque>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+
+#include "bsd_getopt.h"
+#include "SegmenterManager.h"
+#include "Segmenter.h"
+#include "SegmentTrace.h"
+#include "mmseg_proto.h"
+
+using namespace css;
+
+/*
+mmseg-server, serve segmentation over a unix domain socket or loopback tcp.
+- one SegmenterManager, the dictionaries are loaded once and shared by all workers.
+- the io thread polls all connections, cuts frames and queues them as jobs.
+- a fixed pool of workers, each owns a Segmenter, segments the jobs and writes the responses.
+- sockets are non-blocking: a response the socket can not take at once is queued on its
+  connection and written by the io thread on POLLOUT. A connection with MAX_INFLIGHT jobs
+  or MAX_OUTPUT bytes unsent is not read, so a client not reading its responses stalls
+  only itself.
+see mmseg_proto.h for the wire protocol.
+*/
+
+#define MAX_INFLIGHT	64	//jobs of a connection queued or being segmented
+#define MAX_OUTPUT		(4*1024*1024)	//bytes of a connection's responses not sent yet
+
+struct Connection {
+	int fd;
+	std::vector<char> rbuf;
+	size_t rlen;
+	int refs;			//protected by g_conn_lock
+	pthread_mutex_t olock;	//guards the fields below
+	std::vector<char> obuf;	//responses not sent yet, from opos
+	size_t opos;
+	int inflight;		//jobs cut but not answered
+	int broken;			//write failed, the io thread closes it
+};
+
+struct Job {
+	Connection* conn;
+	char* frame;	//the frame without length field
+	u4 size;
+};
+
+static pthread_mutex_t g_conn_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t g_job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_job_cond = PTHREAD_COND_INITIALIZER;
+static std::deque<Job> g_jobs;
+static volatile sig_atomic_t g_stop = 0;
+static volatile sig_atomic_t g_trace_dump = 0;
+static volatile sig_atomic_t g_trace_toggle = 0;
+static int g_wake[2] = {-1, -1};	//a byte written wakes the io thread from poll
+
+static void on_signal(int sig)
+{
+	if(sig == SIGUSR1)
+		g_trace_dump = 1;
+	else if(sig == SIGUSR2)
+		g_trace_toggle = 1;
+	else
+		g_stop = 1;
+}
+
+void usage(const char* argv_0) {
+	printf("Coreseek COS(tm) MM Segment Server 1.0\n");
+	printf("Copyright By Coreseek.com All Right Reserved.\n");
+	printf("Usage: %s -d <dict_path> <option>\n",argv_0);
+	printf("-d <dict_path>   the path with contains dictionaries & mmseg.ini\n");
+	printf("-s <socket>      listen on unix domain socket\n");
+	printf("-p <port>        listen on 127.0.0.1:<port>, if -s not assigned\n");
+	printf("-w <num>         worker threads, default 4\n");
+	printf("-T <num>         trace 1 of each <num> documents, default off. SIGUSR2 switches it on/off\n");
+	printf("-t <file>        the trace is written to <file> on SIGUSR1, default mmseg.trace\n");
+	printf("-h               print this help and exit\n");
+	return;
+}
+
+static void conn_release(Connection* conn)
+{
+	pthread_mutex_lock(&g_conn_lock);
+	int refs = --conn->refs;
+	pthread_mutex_unlock(&g_conn_lock);
+	if(refs)
+		return;
+	close(conn->fd);
+	pthread_mutex_destroy(&conn->olock);
+	delete conn;
+}
+
+static void server_wake()
+{
+	char c = 0;
+	//a full pipe wakes it already.
+	if(write(g_wake[1], &c, 1) < 0)
+		return;
+}
+
+/*
+write buf as far as the non-blocking fd takes.
+@return bytes written, -1 if the connection is broken
+*/
+static ssize_t write_some(int fd, const char* buf, size_t len)
+{
+	size_t done = 0;
+	while(done < len) {
+		ssize_t n = write(fd, buf + done, len - done);
+		if(n < 0 && errno == EINTR)
+			continue;
+		if(n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		if(n <= 0)
+			return -1;
+		done += n;
+	}
+	return (ssize_t)done;
+}
+
+/*
+write the queued output as far as the socket takes, olock held.
+@return -1, the connection is broken
+*/
+static int conn_flush_locked(Connection* conn)
+{
+	if(conn->opos == conn->obuf.size())
+		return 0;
+	ssize_t n = write_some(conn->fd, &conn->obuf[0] + conn->opos, conn->obuf.size() - conn->opos);
+	if(n < 0) {
+		conn->broken = 1;
+		return -1;
+	}
+	conn->opos += n;
+	if(conn->opos == conn->obuf.size()) {
+		conn->obuf.clear();
+		conn->opos = 0;
+	}
+	return 0;
+}
+
+/*
+send a response of a job, the part the socket does not take is left to the io thread.
+*/
+static void conn_send(Connection* conn, const std::vector<char>& out, int bad)
+{
+	int wake = 0;
+	pthread_mutex_lock(&conn->olock);
+	if(bad)
+		conn->broken = 1;
+	if(!conn->broken) {
+		//written at once if nothing is queued, else after the queued ones.
+		ssize_t n = 0;
+		if(conn->opos == conn->obuf.size())
+			n = write_some(conn->fd, &out[0], out.size());
+		if(n < 0)
+			conn->broken = 1;
+		else if((size_t)n < out.size())
+			conn->obuf.insert(conn->obuf.end(), out.begin() + n, out.end());
+	}
+	//the io thread polls POLLOUT, closes a broken one, or reads again below the limits.
+	if(conn->opos < conn->obuf.size() || conn->broken || conn->inflight == MAX_INFLIGHT)
+		wake = 1;
+	conn->inflight--;
+	pthread_mutex_unlock(&conn->olock);
+	if(wake)
+		server_wake();
+}
+
+static void job_push(Job& job)
+{
+	pthread_mutex_lock(&g_job_lock);
+	g_jobs.push_back(job);
+	pthread_cond_signal(&g_job_cond);
+	pthread_mutex_unlock(&g_job_lock);
+}
+
+/*
+@return 0, got a job
+@return -1, server is stopping and no more job.
+*/
+static int job_pop(Job& job)
+{
+	pthread_mutex_lock(&g_job_lock);
+	while(g_jobs.empty() && !g_stop)
+		pthread_cond_wait(&g_job_cond, &g_job_lock);
+	if(g_jobs.empty()) {
+		pthread_mutex_unlock(&g_job_lock);
+		return -1;
+	}
+	job = g_jobs.front();
+	g_jobs.pop_front();
+	pthread_mutex_unlock(&g_job_lock);
+	return 0;
+}
+
+/*
+append token_count and offsets of buf to out.
+*/
+static void segment_doc(Segmenter* seg, u1* buf, u4 length, std::vector<char>& out)
+{
+	size_t count_pos = out.size();
+	out.resize(count_pos + sizeof(u4));
+	u4 count = 0;
+	seg->setBuffer(buf, length);
+	while(1) {
+		u2 len = 0, symlen = 0;
+		const u1* tok = seg->peekToken(len, symlen);
+		if(!tok || !*tok || !len)
+			break;
+		u4 start = (u4)(seg->m_buffer_ptr - buf);
+		seg->popToken(len);
+		size_t pos = out.size();
+		out.resize(pos + sizeof(u4)*2);
+		mmseg_put_u4(&out[pos], start);
+		mmseg_put_u4(&out[pos + sizeof(u4)], start + len);
+		count++;
+	}
+	mmseg_put_u4(&out[count_pos], count);
+}
+
+/*
+@return 0, ok
+@return -1, malformed frame
+*/
+static int process_job(Segmenter* seg, Job& job, std::vector<char>& out, std::vector<u1>& doc)
+{
+	if(job.size < MMSEG_PROTO_HEADER_SIZE - sizeof(u4))
+		return -1;
+	const char* ptr = job.frame;
+	const char* end = job.frame + job.size;
+	u4 id = mmseg_get_u4(ptr);
+	u4 count = mmseg_get_u4(ptr + sizeof(u4));
+	ptr += sizeof(u4)*2;
+
+	out.resize(MMSEG_PROTO_HEADER_SIZE);
+	mmseg_put_u4(&out[sizeof(u4)], id);
+	mmseg_put_u4(&out[sizeof(u4)*2], count);
+	for(u4 i = 0; i < count; i++) {
+		if(end - ptr < (int)sizeof(u4))
+			return -1;
+		u4 doc_len = mmseg_get_u4(ptr);
+		ptr += sizeof(u4);
+		if((u4)(end - ptr) < doc_len)
+			return -1;
+		//segmenter needs a NUL terminated buffer.
+		doc.resize(doc_len + 1);
+		memcpy(&doc[0], ptr, doc_len);
+		doc[doc_len] = 0;
+		ptr += doc_len;
+		segment_doc(seg, &doc[0], doc_len, out);
+	}
+	mmseg_put_u4(&out[0], (u4)(out.size() - sizeof(u4)));
+	return 0;
+}
+
+static void* worker_main(void* arg)
+{
+	Segmenter* seg = (Segmenter*)arg;
+	std::vector<char> out;
+	std::vector<u1> doc;
+	Job job;
+	while(job_pop(job) == 0) {
+		Connection* conn = job.conn;
+		if(process_job(seg, job, out, doc) == 0)
+			conn_send(conn, out, 0);
+		else
+			conn_send(conn, out, 1); //malformed, the io thread closes it
+		free(job.frame);
+		conn_release(conn);
+	}
+	return NULL;
+}
+
+/*
+@return 1, the connection is at its limits, it is not read until the workers catch up.
+*/
+static int conn_full_locked(Connection* conn)
+{
+	return conn->inflight >= MAX_INFLIGHT || conn->obuf.size() - conn->opos >= MAX_OUTPUT;
+}
+
+/*
+cut the complete frames in rbuf into jobs, up to the limits; the rest wait in rbuf.
+@return -1, malformed frame
+*/
+static int conn_dispatch(Connection* conn)
+{
+	size_t pos = 0;
+	while(conn->rlen - pos >= sizeof(u4)) {
+		u4 len = mmseg_get_u4(&conn->rbuf[pos]);
+		if(len < MMSEG_PROTO_HEADER_SIZE - sizeof(u4) || len > MMSEG_PROTO_MAX_FRAME)
+			return -1;
+		if(conn->rlen - pos - sizeof(u4) < len) {
+			//wait for the rest
+			if(conn->rbuf.size() < len + sizeof(u4))
+				conn->rbuf.resize(len + sizeof(u4));
+			break;
+		}
+		pthread_mutex_lock(&conn->olock);
+		int full = conn_full_locked(conn);
+		if(!full)
+			conn->inflight++;
+		pthread_mutex_unlock(&conn->olock);
+		if(full)
+			break;
+		Job job;
+		job.conn = conn;
+		job.size = len;
+		job.frame = (char*)malloc(len);
+		if(!job.frame) {
+			pthread_mutex_lock(&conn->olock);
+			conn->inflight--;
+			pthread_mutex_unlock(&conn->olock);
+			return -1;
+		}
+		memcpy(job.frame, &conn->rbuf[pos + sizeof(u4)], len);
+		pthread_mutex_lock(&g_conn_lock);
+		conn->refs++;
+		pthread_mutex_unlock(&g_conn_lock);
+		job_push(job);
+		pos += sizeof(u4) + len;
+	}
+	if(pos) {
+		memmove(&conn->rbuf[0], &conn->rbuf[pos], conn->rlen - pos);
+		conn->rlen -= pos;
+	}
+	return 0;
+}
+
+static int listen_on(const char* sock_path, int port)
+{
+	int fd = -1;
+	if(sock_path) {
+		struct sockaddr_un addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, sock_path, sizeof(addr.sun_path) - 1);
+		unlink(sock_path);
+		fd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if(fd < 0 || bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+			return -1;
+	}else{
+		struct sockaddr_in addr;
+		memset(&addr, 0, sizeof(addr));
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons((unsigned short)port);
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		fd = socket(AF_INET, SOCK_STREAM, 0);
+		int one = 1;
+		if(fd < 0)
+			return -1;
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+		if(bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+			return -1;
+	}
+	if(listen(fd, 128) != 0)
+		return -1;
+	return fd;
+}
+
+static void trace_control(u4 trace_sampling, const char* trace_file)
+{
+	if(g_trace_toggle) {
+		g_trace_toggle = 0;
+		SegmentTrace::setSampling(SegmentTrace::getSampling() ? 0 : trace_sampling);
+		printf("mmseg-server trace %s\n", SegmentTrace::getSampling() ? "on" : "off");
+		fflush(stdout);
+	}
+	if(g_trace_dump) {
+		g_trace_dump = 0;
+		if(SegmentTrace::dump(trace_file) != 0)
+			perror(trace_file);
+		else
+			printf("mmseg-server trace written to %s\n", trace_file);
+		fflush(stdout);
+	}
+}
+
+static void serve(int listen_fd, int is_tcp, u4 trace_sampling, const char* trace_file)
+{
+	std::vector<Connection*> conns;
+	std::vector<struct pollfd> fds;
+	char drain[64];
+	while(!g_stop) {
+		//fds: the listener, the wake pipe, then each connection.
+		fds.resize(conns.size() + 2);
+		fds[0].fd = listen_fd;
+		fds[0].events = POLLIN;
+		fds[1].fd = g_wake[0];
+		fds[1].events = POLLIN;
+		for(size_t i = 0; i < conns.size(); i++) {
+			Connection* conn = conns[i];
+			fds[i+2].fd = conn->fd;
+			fds[i+2].events = 0;
+			pthread_mutex_lock(&conn->olock);
+			if(!conn_full_locked(conn))
+				fds[i+2].events |= POLLIN;
+			if(conn->opos < conn->obuf.size())
+				fds[i+2].events |= POLLOUT;
+			pthread_mutex_unlock(&conn->olock);
+		}
+		int n = poll(&fds[0], fds.size(), 500);
+		trace_control(trace_sampling, trace_file);
+		if(n < 0)
+			continue;
+		if(fds[1].revents & POLLIN) {
+			while(read(g_wake[0], drain, sizeof(drain)) > 0)
+				;
+		}
+		//only the connections polled, the ones accepted below wait for the next round.
+		size_t k = 0;
+		for(size_t i = 0; i < conns.size(); i++) {
+			Connection* conn = conns[i];
+			short revents = fds[i+2].revents;
+			int closed = 0;
+			if(revents & POLLIN) {
+				if(conn->rlen == conn->rbuf.size())
+					conn->rbuf.resize(conn->rbuf.size()*2);
+				ssize_t r = read(conn->fd, &conn->rbuf[conn->rlen], conn->rbuf.size() - conn->rlen);
+				if(r < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+					; //try again next round
+				else
+				if(r <= 0)
+					closed = 1;
+				else
+					conn->rlen += r;
+			}else if(revents & (POLLHUP|POLLERR|POLLNVAL))
+				closed = 1; //not read while at its limits, the peer is gone.
+			pthread_mutex_lock(&conn->olock);
+			if(revents & POLLOUT)
+				conn_flush_locked(conn);
+			if(conn->broken)
+				closed = 1;
+			pthread_mutex_unlock(&conn->olock);
+			//frames left in rbuf at the limits are cut as the workers catch up.
+			if(!closed && conn_dispatch(conn) != 0)
+				closed = 1;
+			if(closed) {
+				shutdown(conn->fd, SHUT_RDWR);
+				conn_release(conn);
+			}else
+				conns[k++] = conn;
+		}
+		conns.resize(k);
+		if(fds[0].revents & POLLIN) {
+			int fd = accept(listen_fd, NULL, NULL);
+			if(fd >= 0) {
+				if(is_tcp) {
+					int one = 1;
+					setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+				}
+				fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+				Connection* conn = new Connection();
+				conn->fd = fd;
+				conn->rbuf.resize(64*1024);
+				conn->rlen = 0;
+				conn->refs = 1; //the io thread's
+				pthread_mutex_init(&conn->olock, NULL);
+				conn->opos = 0;
+				conn->inflight = 0;
+				conn->broken = 0;
+				conns.push_back(conn);
+			}
+		}
+	}
+	for(size_t i = 0; i < conns.size(); i++) {
+		shutdown(conns[i]->fd, SHUT_RDWR);
+		conn_release(conns[i]);
+	}
+}
+
+int main(int argc, char **argv) {
+	int c;
+	const char* dict_path = NULL;
+	const char* sock_path = NULL;
+	int port = 0;
+	int workers = 4;
+	u4 trace_sampling = 0;
+	const char* trace_file = "mmseg.trace";
+
+	while ((c = getopt(argc, argv, "d:s:p:w:T:t:h")) != -1) {
+		switch (c) {
+		case 'd':
+			dict_path = optarg;
+			break;
+		case 's':
+			sock_path = optarg;
+			break;
+		case 'p':
+			port = atoi(optarg);
+			break;
+		case 'w':
+			workers = atoi(optarg);
+			break;
+		case 'T':
+			trace_sampling = (u4)atoi(optarg);
+			break;
+		case 't':
+			trace_file = optarg;
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(0);
+		default:
+			fprintf(stderr, "Illegal argument \"%c\"\n", c);
+			return 1;
+		}
+	}
+	if(!dict_path || (!sock_path && port <= 0) || workers <= 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	SegmenterManager* mgr = new SegmenterManager();
+	int nRet = mgr->init(dict_path);
+	if(nRet != 0) {
+		fprintf(stderr, "Can NOT load dictionaries from %s\n", dict_path);
+		return 1;
+	}
+	int listen_fd = listen_on(sock_path, port);
+	if(listen_fd < 0) {
+		perror("listen");
+		return 1;
+	}
+	if(pipe(g_wake) != 0) {
+		perror("pipe");
+		return 1;
+	}
+	fcntl(g_wake[0], F_SETFL, fcntl(g_wake[0], F_GETFL) | O_NONBLOCK);
+	fcntl(g_wake[1], F_SETFL, fcntl(g_wake[1], F_GETFL) | O_NONBLOCK);
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, on_signal);
+	signal(SIGTERM, on_signal);
+	signal(SIGUSR1, on_signal);
+	signal(SIGUSR2, on_signal);
+	SegmentTrace::setSampling(trace_sampling);
+	if(!trace_sampling)
+		trace_sampling = 100; //used by SIGUSR2
+
+	//segmenters are taken here, getSegmenter is not thread-safe.
+	std::vector<pthread_t> threads(workers);
+	std::vector<Segmenter*> segs(workers);
+	for(int i = 0; i < workers; i++) {
+		segs[i] = mgr->getSegmenter(false);
+		pthread_create(&threads[i], NULL, worker_main, segs[i]);
+	}
+	if(sock_path)
+		printf("mmseg-server listen on %s, %d workers\n", sock_path, workers);
+	else
+		printf("mmseg-server listen on 127.0.0.1:%d, %d workers\n", port, workers);
+	fflush(stdout);
+
+	serve(listen_fd, sock_path == NULL, trace_sampling, trace_file);
+
+	close(listen_fd);
+	if(sock_path)
+		unlink(sock_path);
+	pthread_mutex_lock(&g_job_lock);
+	pthread_cond_broadcast(&g_job_cond);
+	pthread_mutex_unlock(&g_job_lock);
+	for(int i = 0; i < workers; i++) {
+		pthread_join(threads[i], NULL);
+		delete segs[i];
+	}
+	close(g_wake[0]);
+	close(g_wake[1]);
+	delete mgr;
+	return 0;
+}
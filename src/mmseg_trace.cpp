@@ -0,0 +1,120 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#include <cstdio>
+#include <vector>
+#include <stdlib.h>
+#include <string.h>
+
+#include "SegmentTrace.h"
+
+using namespace css;
+
+/*
+mmseg-trace, print the trace file written by SegmentTrace::dump.
+*/
+
+void usage(const char* argv_0) {
+	printf("Coreseek COS(tm) MM Segment Trace Decoder 1.0\n");
+	printf("Copyright By Coreseek.com All Right Reserved.\n");
+	printf("Usage: %s <trace_file>\n",argv_0);
+	printf("The trace file is written by mmseg -T, or mmseg-server -t on SIGUSR1.\n");
+	return;
+}
+
+static void print_record(const TraceRecord& rec)
+{
+	printf("%10u ", rec.seq);
+	switch(rec.type) {
+	case TraceRecord::DOCUMENT:
+		printf("document length=%u\n", rec.value);
+		break;
+	case TraceRecord::CHUNK:
+		printf("  chunk offset=%u length=%u\n", rec.value, rec.pos);
+		break;
+	case TraceRecord::CANDIDATE:
+		printf("    candidate @%u [", rec.pos);
+		for(int i = 0; i < rec.count && i < 3; i++)
+			printf(i ? " %u:%u" : "%u:%u", rec.lens[i], rec.freqs[i]);
+		printf("] total=%u avl=%.2f var=%.2f freedom=%.2f\n", rec.value, rec.avl, rec.var, rec.freedom);
+		break;
+	case TraceRecord::DECISION:
+		printf("    decision @%u length=%u rule=%u (%u chunks left by rule 1)\n",
+			rec.pos, rec.value, rec.rule, rec.count);
+		break;
+	default:
+		printf("unknown record type %u\n", rec.type);
+		break;
+	}
+}
+
+int main(int argc, char **argv) {
+	if(argc < 2 || strcmp(argv[1], "-h") == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+	FILE* fp = fopen(argv[1], "rb");
+	if(!fp) {
+		fprintf(stderr, "Can not open %s\n", argv[1]);
+		return 1;
+	}
+	_csr_trace_fileheader head;
+	if(fread(&head, sizeof(head), 1, fp) != 1 || memcmp(head.mg, trace_head_mgc, 4) != 0) {
+		fprintf(stderr, "Bad trace file %s\n", argv[1]);
+		fclose(fp);
+		return 1;
+	}
+	if(head.version != 1 || head.record_size != sizeof(TraceRecord)) {
+		fprintf(stderr, "Unsupported trace version %d, record size %d\n", head.version, head.record_size);
+		fclose(fp);
+		return 1;
+	}
+	std::vector<TraceRecord> records;
+	for(u4 i = 0; i < head.ring_count; i++) {
+		_csr_trace_ringheader rh;
+		if(fread(&rh, sizeof(rh), 1, fp) != 1)
+			break;
+		records.resize(rh.count);
+		if(rh.count && fread(&records[0], sizeof(TraceRecord), rh.count, fp) != rh.count)
+			break;
+		printf("ring %u: %u records, %u written\n", rh.index, rh.count, rh.head);
+		u4 expect = rh.count ? records[0].seq : 0;
+		//skip up to the first document, the older part of its records has been overwritten.
+		u1 synced = 0;
+		for(u4 j = 0; j < rh.count; j++, expect++) {
+			const TraceRecord& rec = records[j];
+			if(rec.seq != expect) {
+				//left out by dump, they were written while dumping.
+				printf("%10u %u records dropped, written while dumping\n", expect, rec.seq - expect);
+				expect = rec.seq;
+				synced = 0;
+			}
+			if(!synced && rec.type != TraceRecord::DOCUMENT)
+				continue;
+			synced = 1;
+			print_record(rec);
+		}
+	}
+	fclose(fp);
+	return 0;
+}
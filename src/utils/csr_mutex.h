@@ -0,0 +1,66 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*- */
+/* ***** BEGIN LICENSE BLOCK *****
+* Version: GPL 2.0
+*
+* This program is free software; you can redistribute it and/or modify
+* it under the terms of the GNU General Public License. You should have
+* received a copy of the GPL license along with this program; if you
+* did not, you can find it at http://www.gnu.org/
+*
+* Software distributed under the License is distributed on an "AS IS" basis,
+* WITHOUT WARRANTY OF ANY KIND, either express or implied. See the License
+* for the specific language governing rights and limitations under the
+* License.
+*
+* The Original Code is Coreseek.com code.
+*
+* Copyright (C) 2007-2008. All Rights Reserved.
+*
+* Author:
+*	Li monan <li.monan@gmail.com>
+*
+* ***** END LICENSE BLOCK ***** */
+
+#ifndef _CSR_MUTEX_H_
+#define _CSR_MUTEX_H_
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+//orders the memory accesses before it against the ones after, for the lock free parts.
+#ifdef WIN32
+#define CSR_MEMORY_BARRIER()	MemoryBarrier()
+#else
+#define CSR_MEMORY_BARRIER()	__sync_synchronize()
+#endif
+
+/*
+a plain mutex, for the parts of the library shared between threads.
+*/
+class CsrMutex {
+public:
+#ifdef WIN32
+	CsrMutex() { InitializeCriticalSection(&m_cs); }
+	~CsrMutex() { DeleteCriticalSection(&m_cs); }
+	void lock() { EnterCriticalSection(&m_cs); }
+	void unlock() { LeaveCriticalSection(&m_cs); }
+#else
+	CsrMutex() { pthread_mutex_init(&m_mutex, NULL); }
+	~CsrMutex() { pthread_mutex_destroy(&m_mutex); }
+	void lock() { pthread_mutex_lock(&m_mutex); }
+	void unlock() { pthread_mutex_unlock(&m_mutex); }
+#endif
+private:
+	CsrMutex(const CsrMutex&);
+	CsrMutex& operator=(const CsrMutex&);
+#ifdef WIN32
+	CRITICAL_SECTION m_cs;
+#else
+	pthread_mutex_t m_mutex;
+#endif
+};
+
+#endif